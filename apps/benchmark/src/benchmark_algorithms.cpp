@@ -1,6 +1,7 @@
 #include "activity_detection/activity_detection_noise_estimation.h"
 #include "bandsplit_downsample/bandsplit_downsample_chebyshev.h"
 #include "beamformer/beamformer_mvdr.h"
+#include "beamformer/beamformer_mvdr_recursive.h"
 #include "benchmark/benchmark.h"
 #include "critical_bands/critical_bands_bark.h"
 #include "dc_remover/dc_remover_first_order.h"
@@ -10,8 +11,12 @@
 #include "fft/fft_real.h"
 #include "filter_min_max/filter_min_max_lemire.h"
 #include "filter_power_spectrum/calculate_filter_power_spectrum.h"
+#include "filterbank/filterbank_processor.h"
+#include "filterbank/filterbank_single_channel.h"
 #include "filterbank/filterbank_wola.h"
 #include "filterbank_set/filterbank_set_wola.h"
+#include "fir_filter/fir_filter_partitioned.h"
+#include "fir_filter/fir_filter_time_domain.h"
 #include "gain_calculation/gain_calculation_apriori.h"
 #include "iir_filter/iir_filter_2nd_order.h"
 #include "iir_filter_non_parametric/iir_filter_design_non_parametric.h"
@@ -22,6 +27,7 @@
 #include "noise_estimation/noise_estimation_activity_detection.h"
 #include "noise_reduction/noise_reduction_apriori.h"
 #include "noise_reduction/noise_reduction_ml.h"
+#include "noise_reduction/noise_reduction_ml_native.h"
 #include "normal3d/normal3d_diff.h"
 #include "preprocessing_path/beamformer_path.h"
 #include "single_channel_path/noise_reduction_path.h"
@@ -31,7 +37,12 @@
 #include "spectral_compressor/spectral_selector.h"
 #include "spectrogram/spectrogram_filterbank.h"
 #include "spectrogram/spectrogram_nonlinear.h"
+#include "spectrogram/spectrogram_nonlinear_kernel.h"
 #include "spline/spline_cubic.h"
+#include "utilities/fastonebigheader.h"
+#include "utilities/vector_math.h"
+#include <string>
+#include <vector>
 
 // Macro for defining timing test using google benchmark framework
 #define DEFINE_BENCHMARK_ALGORITHM(algorithm)                                                                                                                                 \
@@ -49,7 +60,8 @@
     }                                                                                                                                                                         \
     BENCHMARK(algorithm##_process);
 
-// insert algorithms to be benchmarked. Be very careful about interpreting these results since the time depends on where in the list an algorithm is placed!
+// insert algorithms to be benchmarked with their default coefficients. Be very careful about interpreting these results since the time depends on where in the list an
+// algorithm is placed! See the configuration grids at the end of this file for benchmarks of realistic configurations
 DEFINE_BENCHMARK_ALGORITHM(CircularBuffer)
 DEFINE_BENCHMARK_ALGORITHM(DesignIIRMinPhaseTF2SOS)
 DEFINE_BENCHMARK_ALGORITHM(DesignIIRSpline)
@@ -57,6 +69,7 @@ DEFINE_BENCHMARK_ALGORITHM(StateVariableFilter)
 DEFINE_BENCHMARK_ALGORITHM(StateVariableFilterCascade)
 DEFINE_BENCHMARK_ALGORITHM(IIRFilterTDFNonParametric)
 DEFINE_BENCHMARK_ALGORITHM(BeamformerMVDR)
+DEFINE_BENCHMARK_ALGORITHM(BeamformerMVDRRecursive)
 DEFINE_BENCHMARK_ALGORITHM(FilterbankSetAnalysis)
 DEFINE_BENCHMARK_ALGORITHM(FilterbankSetSynthesis)
 DEFINE_BENCHMARK_ALGORITHM(BeamformerPath)
@@ -71,8 +84,10 @@ DEFINE_BENCHMARK_ALGORITHM(IIRFilter2ndOrder)
 DEFINE_BENCHMARK_ALGORITHM(SolverToeplitzSystem)
 DEFINE_BENCHMARK_ALGORITHM(FilterbankAnalysisWOLA)
 DEFINE_BENCHMARK_ALGORITHM(FilterbankSynthesisWOLA)
+DEFINE_BENCHMARK_ALGORITHM(FilterbankProcessor)
 DEFINE_BENCHMARK_ALGORITHM(SpectrogramFilterbank)
 DEFINE_BENCHMARK_ALGORITHM(SpectrogramNonlinear)
+DEFINE_BENCHMARK_ALGORITHM(SpectrogramNonlinearKernel)
 DEFINE_BENCHMARK_ALGORITHM(Normal3dDiff)
 DEFINE_BENCHMARK_ALGORITHM(MinPhaseSpectrumCepstrum)
 DEFINE_BENCHMARK_ALGORITHM(CriticalBandsBarkSum)
@@ -91,6 +106,7 @@ DEFINE_BENCHMARK_ALGORITHM(CalculateFilterPowerSpectrum)
 DEFINE_BENCHMARK_ALGORITHM(NoiseReductionPath)
 DEFINE_BENCHMARK_ALGORITHM(NoiseReductionAPriori)
 DEFINE_BENCHMARK_ALGORITHM(NoiseReductionML)
+DEFINE_BENCHMARK_ALGORITHM(NoiseReductionMLNative)
 DEFINE_BENCHMARK_ALGORITHM(BandsplitDownsampleChebyshev)
 DEFINE_BENCHMARK_ALGORITHM(CombineBandsplitDownsampleChebyshev)
 DEFINE_BENCHMARK_ALGORITHM(SpectralCompressorWOLA)
@@ -112,5 +128,388 @@ static void FFTInverse_process(benchmark::State &state)
 }
 BENCHMARK(FFTInverse_process);
 
+// benchmark multichannel FFT with nBands output rows, where only every second channel is 16 byte aligned
+static void FFTRealChannels_process(benchmark::State &state)
+{
+    FFTReal algo;
+    const int fftSize = algo.getCoefficients().fftSize;
+    Eigen::ArrayXXf input = Eigen::ArrayXXf::Random(fftSize, state.range(0));
+    Eigen::ArrayXXcf output(FFTConfiguration::convertFFTSizeToNBands(fftSize), state.range(0));
+    for (auto _ : state)
+    {
+        algo.process(input, output);
+        benchmark::DoNotOptimize(algo);
+        benchmark::DoNotOptimize(output);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(FFTRealChannels_process)->RangeMultiplier(2)->Range(1, 32);
+
+// benchmark multichannel FFT with output padded to an even number of rows, so the FFT writes directly to all channels
+static void FFTRealChannelsPadded_process(benchmark::State &state)
+{
+    FFTReal algo;
+    const int fftSize = algo.getCoefficients().fftSize;
+    const int nBands = FFTConfiguration::convertFFTSizeToNBands(fftSize);
+    Eigen::ArrayXXf input = Eigen::ArrayXXf::Random(fftSize, state.range(0));
+    Eigen::ArrayXXcf output(FFTConfiguration::convertFFTSizeToNBandsPadded(fftSize), state.range(0));
+    for (auto _ : state)
+    {
+        algo.process(input, output.topRows(nBands));
+        benchmark::DoNotOptimize(algo);
+        benchmark::DoNotOptimize(output);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(FFTRealChannelsPadded_process)->RangeMultiplier(2)->Range(1, 32);
+
+// benchmark FFT with size given by argument. 882 is calculated using Bluestein's algorithm and 960 and 1024 are calculated natively
+static void FFTRealSize_process(benchmark::State &state)
+{
+    FFTReal algo({.fftSize = static_cast<int>(state.range(0))});
+    auto input = algo.initInput();
+    auto output = algo.initOutput(input);
+    for (auto _ : state)
+    {
+        algo.process(input, output);
+        benchmark::DoNotOptimize(algo);
+        benchmark::DoNotOptimize(output);
+    }
+}
+BENCHMARK(FFTRealSize_process)->Arg(882)->Arg(960)->Arg(1024);
+
+// benchmark FIR filter implementations with filterLength given by argument. Used for choosing FIRFilterConfiguration::FILTER_LENGTH_TIME_DOMAIN_MAX
+template <typename Talgo>
+static void FIRFilter_process(benchmark::State &state)
+{
+    Talgo algo({.nChannels = 2, .bufferSize = 128, .filterLength = static_cast<int>(state.range(0))});
+    algo.setFilter(Eigen::ArrayXf::Random(state.range(0)));
+    auto input = algo.initInput();
+    auto output = algo.initOutput(input);
+    for (auto _ : state)
+    {
+        algo.process(input, output);
+        benchmark::DoNotOptimize(algo);
+        benchmark::DoNotOptimize(output);
+    }
+}
+BENCHMARK_TEMPLATE(FIRFilter_process, FIRFilterTimeDomain)->RangeMultiplier(2)->Range(8, 1024);
+BENCHMARK_TEMPLATE(FIRFilter_process, FIRFilterPartitioned)->RangeMultiplier(2)->Range(8, 1 << 16);
+
+// benchmark filterbank implementations with WOLA window for nBands and nChannels given by arguments
+template <typename Talgo>
+static void FilterbankWOLA_process(benchmark::State &state)
+{
+    const int nBands = static_cast<int>(state.range(0));
+    Talgo algo({.nChannels = static_cast<int>(state.range(1)), .bufferSize = (nBands - 1) / 2, .nBands = nBands, .filterbankType = Talgo::Coefficients::WOLA});
+    auto input = algo.initInput();
+    auto output = algo.initOutput(input);
+    for (auto _ : state)
+    {
+        algo.process(input, output);
+        benchmark::DoNotOptimize(algo);
+        benchmark::DoNotOptimize(output);
+    }
+}
+BENCHMARK_TEMPLATE(FilterbankWOLA_process, FilterbankAnalysisWOLA)->Args({257, 2})->Args({513, 2})->Args({1025, 2});
+BENCHMARK_TEMPLATE(FilterbankWOLA_process, FilterbankSynthesisWOLA)->Args({257, 2})->Args({513, 2})->Args({1025, 2});
+BENCHMARK_TEMPLATE(FilterbankWOLA_process, FilterbankAnalysisSingleChannel)->Args({257, 1})->Args({513, 1})->Args({1025, 1});
+BENCHMARK_TEMPLATE(FilterbankWOLA_process, FilterbankSynthesisSingleChannel)->Args({257, 1})->Args({513, 1})->Args({1025, 1});
+
+// benchmark WOLA analysis filterbank for a number of channels with the output padded to an even number of rows (padded = 1), so the FFT writes directly to all channels,
+// or with nBands rows (padded = 0), where every second channel goes through a scratch buffer
+static void FilterbankAnalysisWOLAChannels_process(benchmark::State &state)
+{
+    const int nChannels = static_cast<int>(state.range(0));
+    FilterbankAnalysisWOLA algo({.nChannels = nChannels});
+    const int nBands = algo.getNBands();
+    auto input = algo.initInput();
+    Eigen::ArrayXXcf output(state.range(1) ? FFTConfiguration::convertFFTSizeToNBandsPadded(algo.getFFTSize()) : nBands, nChannels);
+    for (auto _ : state)
+    {
+        algo.process(input, output.topRows(nBands));
+        benchmark::DoNotOptimize(algo);
+        benchmark::DoNotOptimize(output);
+    }
+    state.SetItemsProcessed(state.iterations() * nChannels);
+}
+BENCHMARK(FilterbankAnalysisWOLAChannels_process)->ArgsProduct({{2, 4, 8, 16, 32}, {0, 1}})->ArgNames({"nChannels", "padded"});
+
+// benchmark the per-frame overhead of running an ONNX model with bound buffers and a ping-ponged state. model.onnx is an identity model of a single value, so the
+// time is dominated by the overhead in ONNX Runtime and ONNXModel and not by the model itself. Compare to NoiseReductionML_process for the total time
+static void ONNXModelOverhead_run(benchmark::State &state)
+{
+    ONNXModel model("model.onnx", {"modelInput"}, {{1, 1, 1}}, {"modelOutput"}, {{1, 1, 1}});
+    Eigen::ArrayXf input = Eigen::ArrayXf::Random(1), output(1);
+    if (state.range(0)) { model.setState(0, 0); } // output is fed back as input
+    else
+    {
+        model.setInput(0, input);
+        model.setOutput(0, output);
+    }
+    for (auto _ : state)
+    {
+        model.run();
+        benchmark::DoNotOptimize(output);
+    }
+}
+BENCHMARK(ONNXModelOverhead_run)->Arg(0)->Arg(1)->ArgNames({"state"});
+
+// benchmark construction of ML noise reduction without (cache = 0) and with (cache = 1) the optimized graph cache in the working directory. The previous instance
+// is destroyed before the next is constructed, so the session is created in every iteration. The optimized graph is saved in the first iteration with cache
+static void NoiseReductionML_construct(benchmark::State &state)
+{
+    ONNXModel::setOptimizedModelDirectory(state.range(0) ? "." : "");
+    for (auto _ : state)
+    {
+        NoiseReductionML algo;
+        benchmark::DoNotOptimize(algo);
+    }
+    ONNXModel::setOptimizedModelDirectory("");
+}
+BENCHMARK(NoiseReductionML_construct)->Arg(0)->Arg(1)->ArgNames({"cache"})->Unit(benchmark::kMillisecond);
+
+// benchmark construction of native ML noise reduction. The weights are released with the last instance, so they are read from the file in every iteration
+static void NoiseReductionMLNative_construct(benchmark::State &state)
+{
+    for (auto _ : state)
+    {
+        NoiseReductionMLNative algo;
+        benchmark::DoNotOptimize(algo);
+    }
+}
+BENCHMARK(NoiseReductionMLNative_construct);
+
+// benchmark ML noise reduction for a number of streams given by the argument. Each stream is a channel with its own recurrent states, and the per_stream counter is
+// the time per stream. The model has a fixed batch size of 1, so it is run once per stream
+static void NoiseReductionMLStreams_process(benchmark::State &state)
+{
+    const int nStreams = static_cast<int>(state.range(0));
+    NoiseReductionML algo({.nBands = 257, .nChannels = nStreams, .algorithmType = NoiseReductionML::Coefficients::ML});
+    auto input = algo.initInput();
+    auto output = algo.initOutput(input);
+    for (auto _ : state)
+    {
+        algo.process(input, output);
+        benchmark::DoNotOptimize(algo);
+        benchmark::DoNotOptimize(output);
+    }
+    state.counters["per_stream"] = benchmark::Counter(nStreams, benchmark::Counter::kIsIterationInvariantRate | benchmark::Counter::kInvert);
+}
+BENCHMARK(NoiseReductionMLStreams_process)->RangeMultiplier(2)->Range(1, 16);
+
+// benchmark native ML noise reduction with float (int8 = 0) or int8 (int8 = 1) weights for a number of streams. The weights are shared by all streams and int8
+// weights are converted to float in small blocks when they are used, so the difference shows the cost of the conversion compared to the smaller weights
+static void NoiseReductionMLNativeStreams_process(benchmark::State &state)
+{
+    const int nStreams = static_cast<int>(state.range(0));
+    NoiseReductionMLNative::Coefficients c;
+    c.nChannels = nStreams;
+    c.algorithmType = state.range(1) ? c.ML_NATIVE_INT8 : c.ML_NATIVE;
+    NoiseReductionMLNative algo(c);
+    auto input = algo.initInput();
+    auto output = algo.initOutput(input);
+    for (auto _ : state)
+    {
+        algo.process(input, output);
+        benchmark::DoNotOptimize(algo);
+        benchmark::DoNotOptimize(output);
+    }
+    state.counters["per_stream"] = benchmark::Counter(nStreams, benchmark::Counter::kIsIterationInvariantRate | benchmark::Counter::kInvert);
+}
+BENCHMARK(NoiseReductionMLNativeStreams_process)->ArgsProduct({{1, 4, 16}, {0, 1}})->ArgNames({"streams", "int8"});
+
+// benchmark math functions on a 257 x 2 array calculated with VectorMath (vectorMath = 1) or with Eigen and the scalar approximations in fastonebigheader.h
+// (vectorMath = 0). The functions are 0: exp, 1: log, 2: pow, 3: sincos, 4: atan2, 5: energy2dB, 6: dB2lin
+static void VectorMath_process(benchmark::State &state)
+{
+    const int function = static_cast<int>(state.range(0));
+    const bool vectorMath = state.range(1);
+    Eigen::ArrayXXf x = Eigen::ArrayXXf::Random(257, 2).abs() + 0.1f;
+    Eigen::ArrayXXf y = Eigen::ArrayXXf::Random(257, 2);
+    Eigen::ArrayXXf output(257, 2), output2(257, 2);
+    for (auto _ : state)
+    {
+        switch (function)
+        {
+        case 0:
+            if (vectorMath) { VectorMath::exp(x, output); }
+            else { output = x.exp(); }
+            break;
+        case 1:
+            if (vectorMath) { VectorMath::log(x, output); }
+            else { output = x.log(); }
+            break;
+        case 2:
+            if (vectorMath) { VectorMath::pow(x, 0.3f, output); }
+            else { output = x.pow(0.3f); }
+            break;
+        case 3:
+            if (vectorMath) { VectorMath::sincos(x, output, output2); }
+            else
+            {
+                output = x.sin();
+                output2 = x.cos();
+            }
+            break;
+        case 4:
+            if (vectorMath) { VectorMath::atan2(y, x, output); }
+            else { output = y.binaryExpr(x, [](float a, float b) { return std::atan2(a, b); }); }
+            break;
+        case 5:
+            if (vectorMath) { VectorMath::energy2dB(x, output); }
+            else { output = x.unaryExpr([](float a) { return energy2dB(a); }); }
+            break;
+        case 6:
+            if (vectorMath) { VectorMath::dB2lin(x, output); }
+            else { output = x.unaryExpr([](float a) { return dB2lin(a); }); }
+            break;
+        }
+        benchmark::DoNotOptimize(output);
+        benchmark::DoNotOptimize(output2);
+    }
+}
+BENCHMARK(VectorMath_process)->ArgsProduct({{0, 1, 2, 3, 4, 5, 6}, {0, 1}})->ArgNames({"function", "vectorMath"});
+
+// benchmark the angle of a complex spectrum as used in ML noise reduction, calculated with VectorMath (vectorMath = 1) or Eigen (vectorMath = 0)
+static void VectorMathArg_process(benchmark::State &state)
+{
+    Eigen::ArrayXXcf x = Eigen::ArrayXXcf::Random(257, 2);
+    Eigen::ArrayXXf phase(257, 2);
+    for (auto _ : state)
+    {
+        if (state.range(0)) { VectorMath::arg(x, phase); }
+        else { phase = x.arg(); }
+        benchmark::DoNotOptimize(phase);
+    }
+}
+BENCHMARK(VectorMathArg_process)->Arg(0)->Arg(1)->ArgNames({"vectorMath"});
+
+// benchmark MVDR beamformers in speech (activity = 1) and noise (activity = 0) frames. BeamformerMVDR has a closed-form solver for 2 channels,
+// fixed-size solvers for 4 and 8 channels and a dynamic-size solver for 3 and 6 channels, and it updates nBands * 4 / filterbankRate bands
+// per frame. BeamformerMVDRRecursive updates all bands every frame.
+template <typename Talgo>
+static void BeamformerMVDRChannels_process(benchmark::State &state)
+{
+    auto c = Talgo().getCoefficients(); // default coefficients of the implementation, which select the beamformer type
+    c.nChannels = static_cast<int>(state.range(0));
+    Talgo algo(c);
+    auto input = algo.initInput();
+    auto output = algo.initOutput(input);
+    std::get<1>(input) = state.range(1) != 0;
+    for (auto _ : state)
+    {
+        algo.process(input, output);
+        benchmark::DoNotOptimize(algo);
+        benchmark::DoNotOptimize(output);
+    }
+}
+BENCHMARK_TEMPLATE(BeamformerMVDRChannels_process, BeamformerMVDR)->ArgsProduct({{2, 3, 4, 6, 8}, {0, 1}})->ArgNames({"nChannels", "activity"});
+BENCHMARK_TEMPLATE(BeamformerMVDRChannels_process, BeamformerMVDRRecursive)->ArgsProduct({{2, 3, 4, 6, 8}, {0, 1}})->ArgNames({"nChannels", "activity"});
+
+// ------------------------------------------------ Configuration grids ------------------------------------------------
+// Benchmark algorithms for all combinations of coefficients in a grid to size deployments. A grid is a list of axes, where each axis is a list of JSON coefficient
+// trees that are merged into the default coefficients of the algorithm, so coefficients that depend on each other are changed together in one axis. Each grid point is
+// registered as a benchmark named after the changed coefficients, e.g. "BeamformerPath_grid/bufferSize:128/nChannels:4", and the label is the full coefficient tree.
+//
+// The realTimeFactor counter is the processing time per second of audio, so 1 / realTimeFactor is the number of streams that one core can process in real time. Write
+// machine-readable results with: --benchmark_filter=_grid --benchmark_out=grid.json --benchmark_out_format=json (or csv)
+template <typename Talgo>
+static void Grid_process(benchmark::State &state, const typename Talgo::Coefficients &c, double audioSecondsPerCall)
+{
+    Talgo algo(c);
+    if (!algo.isConfigurationValid())
+    {
+        state.SkipWithError("invalid configuration");
+        return;
+    }
+    auto input = algo.initInput();
+    auto output = algo.initOutput(input);
+    for (auto _ : state)
+    {
+        algo.process(input, output);
+        benchmark::DoNotOptimize(algo);
+        benchmark::DoNotOptimize(output);
+    }
+    state.counters["realTimeFactor"] = benchmark::Counter(audioSecondsPerCall, benchmark::Counter::kIsIterationInvariantRate | benchmark::Counter::kInvert);
+    state.SetLabel(nlohmann::json(c).dump());
+}
+
+// get all combinations of the values in the axes
+static std::vector<nlohmann::json> getGridPoints(const nlohmann::json &axes)
+{
+    std::vector<nlohmann::json> points = {nlohmann::json::object()};
+    for (auto &axis : axes)
+    {
+        std::vector<nlohmann::json> newPoints;
+        for (auto &point : points)
+        {
+            for (auto &value : axis)
+            {
+                newPoints.push_back(point);
+                newPoints.back().update(value);
+            }
+        }
+        points = newPoints;
+    }
+    return points;
+}
+
+// register a benchmark for each point in the grid. getAudioSecondsPerCall returns the duration of the audio processed in one call to process() for the coefficients
+template <typename Talgo, typename Function>
+static void registerGrid(const std::string &name, const nlohmann::json &axes, Function getAudioSecondsPerCall)
+{
+    for (auto &point : getGridPoints(axes))
+    {
+        nlohmann::json tree = Talgo().getCoefficients(); // default coefficients of the implementation, e.g. the beamformer type of BeamformerMVDRRecursive
+        tree.update(point);
+        const auto c = tree.get<typename Talgo::Coefficients>();
+        const double audioSecondsPerCall = getAudioSecondsPerCall(c);
+
+        std::string benchmarkName = name + "_grid";
+        for (auto &item : point.items())
+        {
+            benchmarkName += "/" + item.key() + ":" + item.value().dump();
+        }
+        benchmark::RegisterBenchmark(benchmarkName.c_str(), [c, audioSecondsPerCall](benchmark::State &state) { Grid_process<Talgo>(state, c, audioSecondsPerCall); });
+    }
+}
+
+// insert configuration grids to be benchmarked. Filterbanks and FIR filters have no sample rate coefficient, so 48 kHz is assumed for them
+static bool registerGrids()
+{
+    using json = nlohmann::json;
+    constexpr double sampleRate = 48000.;
+    const json nChannels = json::array({{{"nChannels", 1}}, {{"nChannels", 2}}, {{"nChannels", 4}}, {{"nChannels", 8}}, {{"nChannels", 16}}, {{"nChannels", 32}}});
+    const json nChannelsArray = json::array({{{"nChannels", 2}}, {{"nChannels", 4}}, {{"nChannels", 8}}, {{"nChannels", 16}}, {{"nChannels", 32}}}); // at least 2 channels
+    const json nBands = json::array({{{"nBands", 129}}, {{"nBands", 257}}, {{"nBands", 513}}, {{"nBands", 1025}}, {{"nBands", 2049}}});
+    const json bufferSize = json::array({{{"bufferSize", 32}}, {{"bufferSize", 128}}, {{"bufferSize", 512}}, {{"bufferSize", 1024}}, {{"bufferSize", 4096}}});
+    // filterbanks with a hop size of a quarter of the FFT size
+    const json nBandsBufferSize = json::array({{{"nBands", 129}, {"bufferSize", 64}},
+                                               {{"nBands", 257}, {"bufferSize", 128}},
+                                               {{"nBands", 513}, {"bufferSize", 256}},
+                                               {{"nBands", 1025}, {"bufferSize", 512}},
+                                               {{"nBands", 2049}, {"bufferSize", 1024}}});
+    // BeamformerPath and NoiseReductionPath use nBands = 2 * bufferSize + 1, so this is 129 to 2049 bands
+    const json bufferSizePath = json::array({{{"bufferSize", 64}}, {{"bufferSize", 128}}, {{"bufferSize", 256}}, {{"bufferSize", 512}}, {{"bufferSize", 1024}}});
+    const json sampleRatePath = json::array({{{"sampleRate", 16000}}, {{"sampleRate", 48000}}});
+
+    auto bufferDuration = [sampleRate](const auto &c) { return c.bufferSize / sampleRate; };
+    auto bufferDurationSampleRate = [](const auto &c) { return c.bufferSize / static_cast<double>(c.sampleRate); };
+    auto frameDuration = [](const auto &c) { return 1. / c.filterbankRate; };
+
+    registerGrid<FilterbankAnalysisWOLA>("FilterbankAnalysisWOLA", {nBandsBufferSize, nChannels}, bufferDuration);
+    registerGrid<FilterbankSynthesisWOLA>("FilterbankSynthesisWOLA", {nBandsBufferSize, nChannels}, bufferDuration);
+    registerGrid<FIRFilterPartitioned>("FIRFilterPartitioned", {bufferSize, nChannels}, bufferDuration);
+    registerGrid<SpectralCompressorWOLA>("SpectralCompressorWOLA", {bufferSize, nChannels}, bufferDurationSampleRate);
+    registerGrid<BeamformerMVDR>("BeamformerMVDR", {nBands, nChannelsArray}, frameDuration);
+    registerGrid<BeamformerMVDRRecursive>("BeamformerMVDRRecursive", {nBands, nChannelsArray}, frameDuration);
+    registerGrid<NoiseReductionAPriori>("NoiseReductionAPriori", {nBands, nChannels}, frameDuration);
+    registerGrid<BeamformerPath>("BeamformerPath", {bufferSizePath, nChannelsArray, sampleRatePath}, bufferDurationSampleRate);
+    registerGrid<NoiseReductionPath>("NoiseReductionPath", {bufferSizePath, sampleRatePath}, bufferDurationSampleRate);
+    return true;
+}
+static const bool gridsRegistered = registerGrids();
+
 // main function
 BENCHMARK_MAIN();
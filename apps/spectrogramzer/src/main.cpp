@@ -1,5 +1,6 @@
-#include "AudioFile.h"
+#include "memory_mapped_wav.h"
 #include <algorithm_library/spectrogram.h>
+#include <cmath>
 #include <cxxopts.hpp>
 #include <iostream>
 #include <pyplot_cpp/pyplot_cpp.h>
@@ -18,12 +19,14 @@ int main(int argc, char **argv)
     std::string outputName;
     float hopSizeMilliseconds;
     float spectrumSizeMilliseconds;
+    int nThreads;
 
     options.add_options()("h,help", "Show help")("v,version", "Print the current version number")("i,input", "Name of input file",
                                                                                                   cxxopts::value(inputName)->default_value("input.wav"))(
         "o,output", "Name of output file", cxxopts::value(outputName)->default_value("output.png"))("t,hop_size", "Size of each time hop between spectrums in milliseconds",
                                                                                                     cxxopts::value(hopSizeMilliseconds)->default_value("10.f"))(
-        "s,spectrum_size", "Size of each frame used for calculating the spectrum in milliseconds", cxxopts::value(spectrumSizeMilliseconds)->default_value("80.f"));
+        "s,spectrum_size", "Size of each frame used for calculating the spectrum in milliseconds", cxxopts::value(spectrumSizeMilliseconds)->default_value("80.f"))(
+        "j,threads", "Number of threads used for calculating the spectrogram. 0 uses all hardware threads", cxxopts::value(nThreads)->default_value("0"));
 
     options.allow_unrecognised_options();
 
@@ -41,31 +44,35 @@ int main(int argc, char **argv)
         return 0;
     }
 
-    AudioFile<float> audioFileInput;
-    audioFileInput.load(inputName);
+    // the input file is memory-mapped, so it is streamed from disk by the threads calculating the spectrogram instead of loaded into memory first
+    MemoryMappedWav audioFileInput(inputName);
     std::cout << "Input file summary:\n";
-    audioFileInput.printSummary();
+    std::cout << "Sample rate: " << audioFileInput.getSampleRate() << "\n";
+    std::cout << "Number of channels: " << audioFileInput.getNChannels() << "\n";
+    std::cout << "Bit depth: " << audioFileInput.getBitDepth() << "\n";
+    std::cout << "Number of samples per channel: " << audioFileInput.getNSamplesPerChannel() << "\n";
     std::cout << "\n";
 
     std::cout << "Processing summary:\n";
     auto c = Spectrogram::Coefficients();
-    c.bufferSize = static_cast<int>(hopSizeMilliseconds / 1000.f * audioFileInput.getSampleRate());
+    int fftSize = static_cast<int>(spectrumSizeMilliseconds / 1000.f * audioFileInput.getSampleRate());
+    fftSize = SpectrogramConfiguration::getValidFFTSize(fftSize);
+    c.nBands = fftSize / 2 + 1;
+    std::cout << "FFT size: " << fftSize << "\n";
+    // the FFT size must be a multiple of the buffer size, so round the ratio to a power of 2 between 2 and 32 (valid FFT sizes are multiples of 32)
+    const float hopSize = hopSizeMilliseconds / 1000.f * audioFileInput.getSampleRate();
+    const int log2Factor = std::min(std::max(static_cast<int>(std::round(std::log2(fftSize / hopSize))), 1), 5);
+    c.bufferSize = fftSize >> log2Factor;
     std::cout << "Buffer size: " << c.bufferSize << "\n";
-    float fftSize = spectrumSizeMilliseconds / 1000.f * audioFileInput.getSampleRate();
-    c.fftSize = Spectrogram::getValidFFTSize(fftSize);
-    std::cout << "FFT size: " << c.fftSize << "\n";
     Spectrogram spectrogram(c);
 
-    int nFrames = audioFileInput.getNumSamplesPerChannel() / c.bufferSize;
+    const int nSamples = audioFileInput.getNSamplesPerChannel();
+    const int nFrames = spectrogram.getNFrames(nSamples);
     std::cout << "Number of frames: " << nFrames << "\n";
-    int nBins = c.fftSize / 2 + 1;
-    ArrayXXf spec(nBins, nFrames);
+    ArrayXXf spec(c.nBands, nFrames);
 
-    for (auto nFrame = 0; nFrame < nFrames; nFrame++)
-    {
-        ArrayXf frameIn = Map<ArrayXf>(&audioFileInput.samples[0][nFrame * c.bufferSize], c.bufferSize);
-        spectrogram.process(frameIn, spec.col(nFrame));
-    }
+    spectrogram.processFrames([&audioFileInput](int startSample, O::Real samples) { audioFileInput.readSamples(startSample, samples); }, nSamples, spec,
+                              nThreads);
 
     spec = 20.f * spec.max(1e-20).log10();
     float maxValue = spec.maxCoeff();
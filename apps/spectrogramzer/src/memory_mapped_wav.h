@@ -0,0 +1,198 @@
+#pragma once
+#include <Eigen/Dense>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// Read-only memory-mapped WAV file. The file is mapped into memory instead of loaded, so samples are read from the OS page cache when they are used and long
+// files don't have to fit in memory. Supports PCM with 16, 24 and 32 bits and IEEE float with 32 bits (also in WAVE_FORMAT_EXTENSIBLE).
+//
+// readSamples() converts samples of a single channel to float and can be called from several threads at the same time.
+//
+// author: Kristian Timm Andersen
+class MemoryMappedWav
+{
+  public:
+    MemoryMappedWav(const std::string &fileName)
+    {
+        mapFile(fileName);
+        try
+        {
+            parseHeader();
+        }
+        catch (...)
+        {
+            unmapFile();
+            throw;
+        }
+    }
+
+    ~MemoryMappedWav() { unmapFile(); }
+
+    MemoryMappedWav(const MemoryMappedWav &) = delete;
+    MemoryMappedWav &operator=(const MemoryMappedWav &) = delete;
+
+    // write samples.size() samples of channel starting at startSample into samples. Samples after the end of the file are set to zero
+    void readSamples(int startSample, Eigen::Ref<Eigen::ArrayXf> samples, int channel = 0) const
+    {
+        const int nSamplesValid = std::max(std::min(static_cast<int>(samples.size()), nSamplesPerChannel - startSample), 0);
+        const uint8_t *frame = sampleData + static_cast<size_t>(startSample) * nChannels * bytesPerSample + static_cast<size_t>(channel) * bytesPerSample;
+        const size_t frameSize = static_cast<size_t>(nChannels) * bytesPerSample;
+        for (auto i = 0; i < nSamplesValid; i++, frame += frameSize)
+        {
+            samples(i) = convertSample(frame);
+        }
+        samples.tail(samples.size() - nSamplesValid).setZero();
+    }
+
+    int getSampleRate() const { return sampleRate; }
+    int getNChannels() const { return nChannels; }
+    int getNSamplesPerChannel() const { return nSamplesPerChannel; }
+    int getBitDepth() const { return 8 * bytesPerSample; }
+
+  private:
+    void mapFile(const std::string &fileName)
+    {
+#ifdef _WIN32
+        fileHandle = CreateFileA(fileName.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (fileHandle == INVALID_HANDLE_VALUE) { throw std::runtime_error("Could not open file: " + fileName); }
+        LARGE_INTEGER size;
+        GetFileSizeEx(fileHandle, &size);
+        fileSize = static_cast<size_t>(size.QuadPart);
+        mappingHandle = CreateFileMappingA(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (mappingHandle == nullptr)
+        {
+            CloseHandle(fileHandle);
+            throw std::runtime_error("Could not memory map file: " + fileName);
+        }
+        fileData = static_cast<const uint8_t *>(MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0));
+        if (fileData == nullptr)
+        {
+            CloseHandle(mappingHandle);
+            CloseHandle(fileHandle);
+            throw std::runtime_error("Could not memory map file: " + fileName);
+        }
+#else
+        const int fileDescriptor = open(fileName.c_str(), O_RDONLY);
+        if (fileDescriptor < 0) { throw std::runtime_error("Could not open file: " + fileName); }
+        struct stat fileStatus;
+        if ((fstat(fileDescriptor, &fileStatus) != 0) || (fileStatus.st_size == 0))
+        {
+            close(fileDescriptor);
+            throw std::runtime_error("Could not read size of file: " + fileName);
+        }
+        fileSize = static_cast<size_t>(fileStatus.st_size);
+        void *data = mmap(nullptr, fileSize, PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+        close(fileDescriptor); // the mapping keeps the file open
+        if (data == MAP_FAILED) { throw std::runtime_error("Could not memory map file: " + fileName); }
+        madvise(data, fileSize, MADV_SEQUENTIAL); // read ahead, since the file is read sequentially by each thread
+        fileData = static_cast<const uint8_t *>(data);
+#endif
+    }
+
+    void unmapFile()
+    {
+#ifdef _WIN32
+        UnmapViewOfFile(fileData);
+        CloseHandle(mappingHandle);
+        CloseHandle(fileHandle);
+#else
+        munmap(const_cast<uint8_t *>(fileData), fileSize);
+#endif
+    }
+
+    // parse RIFF chunks until the "fmt " and "data" chunks are found
+    void parseHeader()
+    {
+        if ((fileSize < 12) || (std::memcmp(fileData, "RIFF", 4) != 0) || (std::memcmp(fileData + 8, "WAVE", 4) != 0)) { throw std::runtime_error("File is not a WAV file"); }
+
+        bool formatFound = false;
+        size_t position = 12;
+        while (position + 8 <= fileSize)
+        {
+            const uint8_t *chunk = fileData + position;
+            const size_t chunkSize = readLittleEndian<uint32_t>(chunk + 4);
+            if ((std::memcmp(chunk, "fmt ", 4) == 0) && (chunkSize >= 16))
+            {
+                int format = readLittleEndian<uint16_t>(chunk + 8);
+                nChannels = readLittleEndian<uint16_t>(chunk + 10);
+                sampleRate = static_cast<int>(readLittleEndian<uint32_t>(chunk + 12));
+                bytesPerSample = readLittleEndian<uint16_t>(chunk + 22) / 8;
+                if ((format == WAVE_FORMAT_EXTENSIBLE) && (chunkSize >= 26)) { format = readLittleEndian<uint16_t>(chunk + 32); } // first 2 bytes of sub format GUID
+                isFloat = format == WAVE_FORMAT_IEEE_FLOAT;
+                const bool isPCM = (format == WAVE_FORMAT_PCM) && (bytesPerSample >= 2) && (bytesPerSample <= 4);
+                if ((!isPCM && !(isFloat && (bytesPerSample == 4))) || (nChannels < 1))
+                {
+                    throw std::runtime_error("WAV format is not supported");
+                }
+                formatFound = true;
+            }
+            else if (std::memcmp(chunk, "data", 4) == 0)
+            {
+                if (!formatFound) { throw std::runtime_error("WAV file has no format chunk before the data chunk"); }
+                sampleData = chunk + 8;
+                const size_t dataSize = std::min(chunkSize, fileSize - position - 8); // data size might be wrong in files that were not closed properly
+                nSamplesPerChannel = static_cast<int>(dataSize / (static_cast<size_t>(nChannels) * bytesPerSample));
+                return;
+            }
+            position += 8 + chunkSize + (chunkSize & 1); // chunks are padded to an even size
+        }
+        throw std::runtime_error("WAV file has no data chunk");
+    }
+
+    float convertSample(const uint8_t *sample) const
+    {
+        if (isFloat)
+        {
+            float value;
+            std::memcpy(&value, sample, sizeof(float));
+            return value;
+        }
+        switch (bytesPerSample)
+        {
+        case 2: return static_cast<int16_t>(readLittleEndian<uint16_t>(sample)) / 32768.f;
+        case 3: return static_cast<int32_t>((sample[0] << 8) | (sample[1] << 16) | (static_cast<uint32_t>(sample[2]) << 24)) / 2147483648.f; // shift to sign bit
+        default: return static_cast<int32_t>(readLittleEndian<uint32_t>(sample)) / 2147483648.f;
+        }
+    }
+
+    template <typename T>
+    static T readLittleEndian(const uint8_t *data)
+    {
+        T value = 0;
+        for (auto i = 0; i < static_cast<int>(sizeof(T)); i++)
+        {
+            value |= static_cast<T>(data[i]) << (8 * i);
+        }
+        return value;
+    }
+
+    static constexpr int WAVE_FORMAT_PCM = 1;
+    static constexpr int WAVE_FORMAT_IEEE_FLOAT = 3;
+    static constexpr int WAVE_FORMAT_EXTENSIBLE = 0xFFFE;
+
+#ifdef _WIN32
+    HANDLE fileHandle = INVALID_HANDLE_VALUE;
+    HANDLE mappingHandle = nullptr;
+#endif
+    const uint8_t *fileData = nullptr;
+    const uint8_t *sampleData = nullptr;
+    size_t fileSize = 0;
+    int sampleRate = 0;
+    int nChannels = 0;
+    int nSamplesPerChannel = 0;
+    int bytesPerSample = 0;
+    bool isFloat = false;
+};
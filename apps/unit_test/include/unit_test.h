@@ -198,6 +198,35 @@ bool mallocDEBUGTest(const typename Talgo::Coefficients &c = typename Talgo::Coe
     return true;
 }
 
+// count heap allocations made by the calling thread between start and stop, and print the call stack of the first counted allocation.
+// Defined in allocation_counter.cpp
+void startAllocationCounter();
+int stopAllocationCounter();
+void printAllocationCallStack();
+
+// test that process doesn't allocate heap memory. In contrast to mallocDEBUGTest, this test also detects allocations outside of Eigen and in
+// release builds, and it fails instead of asserting
+template <typename Talgo>
+bool processAllocationFreeTest(const typename Talgo::Coefficients &c = typename Talgo::Coefficients(), int nProcessCalls = 10)
+{
+    Talgo algo(c);
+    auto input = algo.initInput();
+    auto output = algo.initOutput(input);
+    startAllocationCounter();
+    for (auto i = 0; i < nProcessCalls; i++)
+    {
+        algo.process(input, output);
+    }
+    const int count = stopAllocationCounter();
+    if (count > 0)
+    {
+        fmt::print("processAllocationFreeTest failed: {} heap allocations in {} calls to process.\n", count, nProcessCalls);
+        printAllocationCallStack();
+        return false;
+    }
+    return true;
+}
+
 template <typename Talgo>
 bool processTest(const typename Talgo::Coefficients &c = typename Talgo::Coefficients())
 {
@@ -281,7 +310,11 @@ bool algorithmInterfaceTest(const typename Talgo::Coefficients &c, bool testMall
     successFlag &= versionAlgorithmTest<Talgo>();
     successFlag &= isConfigurationValidTest<Talgo>(c);
     successFlag &= processTest<Talgo>(c);
-    if (testMallocFlag) { successFlag &= mallocDEBUGTest<Talgo>(c); }
+    if (testMallocFlag)
+    {
+        successFlag &= mallocDEBUGTest<Talgo>(c);
+        successFlag &= processAllocationFreeTest<Talgo>(c);
+    }
     successFlag &= resetTest<Talgo>(c);
     successFlag &= getSetTest<Talgo>(c);
     successFlag &= assertInterfaceTest<Talgo>();
@@ -303,6 +336,9 @@ bool algorithmInterfaceTest(const typename Talgo::Coefficients &c, bool testMall
         fmt::print("algorithmInterfaceTest failed: Dynamic memory size is negative.\n");
     }
 
+    size = algo.getSharedDynamicSize();
+    fmt::print("Shared dynamic memory size: {}\n", size);
+
     if (!successFlag) { fmt::print("algorithmInterfaceTest failed.\n"); }
     fmt::print("----------------------------------------------------------------------------------------------------------------------------------\n");
     return successFlag;
@@ -407,4 +443,4 @@ bool algorithmBufferInterfaceTest()
     return successFlag;
 }
 
-} // namespace InterfaceTests
\ No newline at end of file
+} // namespace InterfaceTests
\ No newline at end of file
@@ -0,0 +1,190 @@
+#include "unit_test.h"
+#include <cerrno>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#include <string>
+#if defined(__GLIBC__)
+#include <cxxabi.h>
+#include <execinfo.h>
+#endif
+
+// Replace the memory allocation functions, so heap allocations made by the calling thread can be counted. On glibc the malloc family
+// (including the aligned and page-aligned variants) is interposed, which also catches allocations made by operator new and by Eigen. On other
+// platforms only operator new is replaced.
+//
+// On glibc the call stack of the first counted allocation is saved, so the allocating function can be found. The function names are only
+// available if the executable exports its symbols (-rdynamic).
+
+namespace
+{
+thread_local bool countingFlag = false;
+thread_local int allocationCount = 0;
+
+constexpr int maxCallStackSize = 32;
+thread_local void *callStack[maxCallStackSize];
+thread_local int callStackSize = 0;
+
+inline void countAllocation()
+{
+    if (countingFlag)
+    {
+        allocationCount++;
+#if defined(__GLIBC__)
+        if (allocationCount == 1)
+        {
+            countingFlag = false; // backtrace might allocate
+            callStackSize = backtrace(callStack, maxCallStackSize);
+            countingFlag = true;
+        }
+#endif
+    }
+}
+
+#if defined(__GLIBC__)
+// convert "binary(mangledName+offset) [address]" to "demangledName+offset"
+std::string demangleSymbol(const char *symbol)
+{
+    std::string s(symbol);
+    const auto begin = s.find('(');
+    const auto end = s.find('+', begin);
+    if (begin == std::string::npos || end == std::string::npos || end == begin + 1) { return s; }
+
+    int status;
+    char *name = abi::__cxa_demangle(s.substr(begin + 1, end - begin - 1).c_str(), nullptr, nullptr, &status);
+    if (status != 0) { return s; }
+    std::string demangled = name + s.substr(end, s.find(')', end) - end);
+    std::free(name);
+    return demangled;
+}
+
+// posix_memalign and aligned_alloc require a power of two alignment, and posix_memalign also requires a multiple of sizeof(void *)
+inline bool isPowerOfTwo(size_t alignment) { return (alignment != 0) && ((alignment & (alignment - 1)) == 0); }
+#endif
+} // namespace
+
+namespace InterfaceTests
+{
+void startAllocationCounter()
+{
+#if defined(__GLIBC__)
+    backtrace(callStack, 1); // the first call to backtrace loads libgcc, which allocates
+#endif
+    callStackSize = 0;
+    allocationCount = 0;
+    countingFlag = true;
+}
+
+int stopAllocationCounter()
+{
+    countingFlag = false;
+    return allocationCount;
+}
+
+void printAllocationCallStack()
+{
+#if defined(__GLIBC__)
+    if (callStackSize == 0) { return; }
+    char **symbols = backtrace_symbols(callStack, callStackSize);
+    if (symbols == nullptr) { return; }
+    fmt::print("Call stack of first heap allocation:\n");
+    for (auto i = 1; i < callStackSize; i++) // skip the replaced allocation function
+    {
+        fmt::print("    #{:<2} {}\n", i - 1, demangleSymbol(symbols[i]));
+    }
+    std::free(symbols);
+#else
+    fmt::print("The call stack of heap allocations is only available with glibc.\n");
+#endif
+}
+} // namespace InterfaceTests
+
+#if defined(__GLIBC__)
+
+extern "C"
+{
+    void *__libc_malloc(size_t size);
+    void *__libc_calloc(size_t n, size_t size);
+    void *__libc_realloc(void *ptr, size_t size);
+    void *__libc_memalign(size_t alignment, size_t size);
+    void *__libc_valloc(size_t size);
+    void *__libc_pvalloc(size_t size);
+
+    void *malloc(size_t size) noexcept
+    {
+        countAllocation();
+        return __libc_malloc(size);
+    }
+
+    void *calloc(size_t n, size_t size) noexcept
+    {
+        countAllocation();
+        return __libc_calloc(n, size);
+    }
+
+    void *realloc(void *ptr, size_t size) noexcept
+    {
+        countAllocation();
+        return __libc_realloc(ptr, size);
+    }
+
+    void *memalign(size_t alignment, size_t size) noexcept
+    {
+        countAllocation();
+        return __libc_memalign(alignment, size);
+    }
+
+    void *aligned_alloc(size_t alignment, size_t size) noexcept
+    {
+        countAllocation();
+        if (!isPowerOfTwo(alignment))
+        {
+            errno = EINVAL;
+            return nullptr;
+        }
+        return __libc_memalign(alignment, size);
+    }
+
+    int posix_memalign(void **ptr, size_t alignment, size_t size) noexcept
+    {
+        countAllocation();
+        if (!isPowerOfTwo(alignment) || (alignment % sizeof(void *) != 0)) { return EINVAL; } // *ptr is not modified
+        void *p = __libc_memalign(alignment, size);
+        if (p == nullptr) { return ENOMEM; }
+        *ptr = p;
+        return 0;
+    }
+
+    void *valloc(size_t size) noexcept
+    {
+        countAllocation();
+        return __libc_valloc(size);
+    }
+
+    void *pvalloc(size_t size) noexcept
+    {
+        countAllocation();
+        return __libc_pvalloc(size);
+    }
+}
+
+#else
+
+void *operator new(std::size_t size)
+{
+    countAllocation();
+    if (void *ptr = std::malloc(size > 0 ? size : 1)) { return ptr; }
+    throw std::bad_alloc();
+}
+
+void *operator new[](std::size_t size)
+{
+    countAllocation();
+    if (void *ptr = std::malloc(size > 0 ? size : 1)) { return ptr; }
+    throw std::bad_alloc();
+}
+
+void operator delete(void *ptr) noexcept { std::free(ptr); }
+void operator delete[](void *ptr) noexcept { std::free(ptr); }
+
+#endif
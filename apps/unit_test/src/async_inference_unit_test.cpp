@@ -0,0 +1,112 @@
+#include "unit_test.h"
+#include "utilities/async_inference.h"
+#include "gtest/gtest.h"
+#include <atomic>
+
+using namespace Eigen;
+
+// recurrent model where the gain depends on all previous inputs. If blocking is set, the model blocks while blockModel is true, so deadline misses can be created
+// deterministically
+std::atomic<bool> blockModel{false};
+
+class RecurrentModel
+{
+  public:
+    struct Coefficients
+    {
+        int nBands = 17;
+        int nChannels = 2;
+        bool blocking = false;
+    };
+
+    RecurrentModel(const Coefficients &c) : state(ArrayXXf::Zero(c.nBands, c.nChannels)), gain(ArrayXXf::Zero(c.nBands, c.nChannels)), blocking(c.blocking) {}
+
+    void process(I::Complex2D xFreq, O::Complex2D yFreq)
+    {
+        while (blocking && blockModel.load())
+        {
+            std::this_thread::yield();
+        }
+        state = 0.9f * state + xFreq.abs2();
+        gain = 1.f / (1.f + state);
+        yFreq = gain * xFreq;
+    }
+
+    const ArrayXXf &getGain() const { return gain; }
+    void reset() { state.setZero(); }
+    size_t getDynamicSize() const { return state.getDynamicMemorySize() + gain.getDynamicMemorySize(); }
+
+    ArrayXXf state, gain;
+    bool blocking;
+};
+
+// --------------------------------------------- TEST CASES ---------------------------------------------
+
+// description: run a recurrent model asynchronously and synchronously on the same input. Block the asynchronous model for as many frames as fit in the queue, so
+// the deadlines are missed and the inputs are queued. Then block it for 2 frames more than fit in the queue
+// pass/fail: the asynchronous output is equal to the synchronous output of the previous frame, except while the deadlines are missed where the gain is held.
+// After the queued frames have been processed, the output is again equal to the delayed synchronous output, since the model has seen every frame. Frames that
+// don't fit in the queue are dropped, counted, and make the output different from the synchronous output
+TEST(AsyncInference, DeadlineMisses)
+{
+    const RecurrentModel::Coefficients c;
+    const int nFramesQueue = AsyncInference<RecurrentModel>::nFramesQueue;
+    RecurrentModel modelSync(c);
+    AsyncInference<RecurrentModel> inference({.nBands = c.nBands, .nChannels = c.nChannels, .blocking = true});
+    ArrayXXcf input(c.nBands, c.nChannels), inputPrevious = ArrayXXcf::Zero(c.nBands, c.nChannels);
+    ArrayXXcf output(c.nBands, c.nChannels), outputSync(c.nBands, c.nChannels), outputSyncPrevious = ArrayXXcf::Zero(c.nBands, c.nChannels);
+    ArrayXXf gainHeld = ArrayXXf::Zero(c.nBands, c.nChannels);
+
+    // process a frame and return the error between the asynchronous output and the delayed synchronous output
+    auto processFrame = [&](bool block) {
+        input = ArrayXXcf::Random(c.nBands, c.nChannels);
+        blockModel = block;
+        modelSync.process(input, outputSync);
+        inference.process(input, output);
+        const float error = (output - outputSyncPrevious).abs2().sum();
+        outputSyncPrevious = outputSync;
+        inputPrevious = input;
+        return error;
+    };
+
+    float error = 0.f;
+    for (auto frame = 0; frame < 5; frame++)
+    {
+        error += processFrame(false);
+        inference.waitForInference();
+    }
+    EXPECT_EQ(error, 0.f);
+    EXPECT_EQ(inference.getDeadlineMisses(), 0);
+
+    // the first blocked frame gets the gain of the previous frame and is submitted. The following frames miss their deadline and are queued
+    gainHeld = modelSync.getGain();
+    error = processFrame(true);
+    float errorHeld = 0.f;
+    for (auto frame = 1; frame < nFramesQueue; frame++)
+    {
+        const ArrayXXcf inputDelayed = inputPrevious;
+        processFrame(true);
+        errorHeld += (output - gainHeld * inputDelayed).abs2().sum();
+    }
+    blockModel = false;
+    inference.waitForInference();
+    error += processFrame(false);
+    inference.waitForInference();
+    fmt::print("Error when queueing frames: {}, error of held gain: {}\n", error, errorHeld);
+    EXPECT_EQ(error, 0.f);
+    EXPECT_EQ(errorHeld, 0.f);
+    EXPECT_EQ(inference.getDeadlineMisses(), nFramesQueue - 1);
+    EXPECT_EQ(inference.getDroppedFrames(), 0);
+
+    // block for 2 frames more than fit in the queue
+    for (auto frame = 0; frame < nFramesQueue + 2; frame++)
+    {
+        processFrame(true);
+    }
+    blockModel = false;
+    inference.waitForInference();
+    error = processFrame(false);
+    fmt::print("Error when dropping frames: {}\n", error);
+    EXPECT_GT(error, 0.f);
+    EXPECT_EQ(inference.getDroppedFrames(), 2);
+}
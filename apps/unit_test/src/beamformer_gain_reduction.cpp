@@ -6,8 +6,4 @@ using namespace Eigen;
 
 // --------------------------------------------- TEST CASES ---------------------------------------------
 
-TEST(BeamformerGainReduction, Interface)
-{
-    bool testMallocFlag = false;
-    EXPECT_TRUE(InterfaceTests::algorithmInterfaceTest<BeamformerGainReduction>(testMallocFlag));
-}
+TEST(BeamformerGainReduction, Interface) { EXPECT_TRUE(InterfaceTests::algorithmInterfaceTest<BeamformerGainReduction>()); }
@@ -0,0 +1,51 @@
+#include "beamformer/beamformer_mvdr_recursive.h"
+#include "unit_test.h"
+#include "gtest/gtest.h"
+
+using namespace Eigen;
+
+// --------------------------------------------- TEST CASES ---------------------------------------------
+
+TEST(BeamformerMVDRRecursive, Interface) { EXPECT_TRUE(InterfaceTests::algorithmInterfaceTest<BeamformerMVDRRecursive>()); }
+
+// description: set the beamformer type that is implemented by BeamformerMVDR
+// pass/fail: the configuration is invalid
+TEST(BeamformerMVDRRecursive, InvalidBeamformerType)
+{
+    BeamformerMVDRRecursive beamformer({.beamformerType = BeamformerConfiguration::Coefficients::EIGEN_DECOMPOSITION});
+    EXPECT_FALSE(beamformer.isConfigurationValid());
+}
+
+// description: estimate the covariance matrices of a point source with a random steering vector in low-level uncorrelated noise, and process
+// the point source without noise. A long noise-only period is used to test the numerical stability of the recursive inverse.
+// pass/fail: the beamformed output is distortionless with respect to channel 0 and the noise output cancels the point source
+TEST(BeamformerMVDRRecursive, PointSource)
+{
+    const int nBands = 65;
+    for (auto nChannels : {2, 3, 4, 8})
+    {
+        BeamformerMVDRRecursive beamformer(
+            {.nChannels = nChannels, .filterbankRate = 125.f, .nBands = nBands, .beamformerType = BeamformerConfiguration::Coefficients::RECURSIVE_INVERSE});
+        ArrayXXcf steering = ArrayXXcf::Random(nBands, nChannels);
+        steering.col(0) = 1.f;
+        ArrayXcf yFreq(nBands), noiseFreq(nBands);
+        for (auto frame = 0; frame < 10500; frame++)
+        {
+            const bool activity = frame >= 10000;
+            ArrayXXcf xFreq = ArrayXXcf::Random(nBands, nChannels) * 1e-2f;
+            if (activity) { xFreq += steering.colwise() * ArrayXcf::Random(nBands); }
+            beamformer.process({xFreq, activity}, {yFreq, noiseFreq});
+        }
+
+        beamformer.setSpeechDecision(BeamformerMVDRRecursive::FREEZE_UPDATE);
+        ArrayXcf source = ArrayXcf::Random(nBands);
+        ArrayXXcf xFreq = steering.colwise() * source;
+        beamformer.process({xFreq, true}, {yFreq, noiseFreq});
+
+        const float errorSignal = (yFreq - source).abs2().sum() / source.abs2().sum();
+        const float errorNoise = noiseFreq.abs2().sum() / source.abs2().sum();
+        fmt::print("nChannels: {}, relative error of beamformed signal: {}, relative power of noise output: {}\n", nChannels, errorSignal, errorNoise);
+        EXPECT_LT(errorSignal, 1e-5f);
+        EXPECT_LT(errorNoise, 1e-5f);
+    }
+}
@@ -6,8 +6,68 @@ using namespace Eigen;
 
 // --------------------------------------------- TEST CASES ---------------------------------------------
 
-TEST(BeamformerMVDR, Interface)
+TEST(BeamformerMVDR, Interface) { EXPECT_TRUE(InterfaceTests::algorithmInterfaceTest<BeamformerMVDR>()); }
+
+// description: set the beamformer type that is implemented by BeamformerMVDRRecursive
+// pass/fail: the configuration is invalid
+TEST(BeamformerMVDR, InvalidBeamformerType)
 {
-    bool testMallocFlag = false;
-    EXPECT_TRUE(InterfaceTests::algorithmInterfaceTest<BeamformerMVDR>(testMallocFlag));
+    BeamformerMVDR beamformer({.beamformerType = BeamformerConfiguration::Coefficients::RECURSIVE_INVERSE});
+    EXPECT_FALSE(beamformer.isConfigurationValid());
+}
+
+// description: process speech and noise frames for channel counts with closed-form, fixed-size and dynamic-size solvers, until the filters in
+// all bands have been updated
+// pass/fail: no heap memory is allocated in process
+TEST(BeamformerMVDR, AllocationFree)
+{
+    for (auto nChannels : {2, 3, 4, 6, 8})
+    {
+        BeamformerMVDR beamformer({.nChannels = nChannels});
+        auto input = beamformer.initInput();
+        auto output = beamformer.initOutput(input);
+        const int nBands = beamformer.getCoefficients().nBands;
+        InterfaceTests::startAllocationCounter();
+        for (auto frame = 0; frame < nBands; frame++)
+        {
+            std::get<1>(input) = frame % 2 == 0;
+            beamformer.process(input, output);
+        }
+        const int count = InterfaceTests::stopAllocationCounter();
+        fmt::print("nChannels: {}, heap allocations: {}\n", nChannels, count);
+        EXPECT_EQ(count, 0);
+    }
+}
+
+// description: estimate the covariance matrices of a point source with a random steering vector in low-level uncorrelated noise, and process
+// the point source without noise. Channel counts with closed-form, fixed-size and dynamic-size solvers are tested.
+// pass/fail: the beamformed output is distortionless with respect to channel 0 and the noise output cancels the point source
+TEST(BeamformerMVDR, PointSource)
+{
+    const int nBands = 65;
+    for (auto nChannels : {2, 3, 4, 8})
+    {
+        BeamformerMVDR beamformer({.nChannels = nChannels, .filterbankRate = 125.f, .nBands = nBands});
+        ArrayXXcf steering = ArrayXXcf::Random(nBands, nChannels);
+        steering.col(0) = 1.f;
+        ArrayXcf yFreq(nBands), noiseFreq(nBands);
+        for (auto frame = 0; frame < 1000; frame++)
+        {
+            const bool activity = frame >= 500;
+            ArrayXXcf xFreq = ArrayXXcf::Random(nBands, nChannels) * 1e-2f;
+            if (activity) { xFreq += steering.colwise() * ArrayXcf::Random(nBands); }
+            beamformer.process({xFreq, activity}, {yFreq, noiseFreq});
+        }
+
+        beamformer.setSpeechDecision(BeamformerMVDR::FREEZE_UPDATE);
+        ArrayXcf source = ArrayXcf::Random(nBands);
+        ArrayXXcf xFreq = steering.colwise() * source;
+        beamformer.process({xFreq, true}, {yFreq, noiseFreq});
+
+        const float errorSignal = (yFreq - source).abs2().sum() / source.abs2().sum();
+        const float errorNoise = noiseFreq.abs2().sum() / source.abs2().sum();
+        fmt::print("nChannels: {}, relative error of beamformed signal: {}, relative power of noise output: {}\n", nChannels, errorSignal, errorNoise);
+        EXPECT_LT(errorSignal, 1e-5f);
+        EXPECT_LT(errorNoise, 1e-5f);
+    }
 }
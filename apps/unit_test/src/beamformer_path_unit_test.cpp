@@ -1,13 +1,130 @@
+#include "algorithm_library/tracing.h"
 #include "preprocessing_path/beamformer_path.h"
 #include "unit_test.h"
 #include "gtest/gtest.h"
+#include <cstdio>
+#include <fstream>
+#include <set>
+#include <thread>
 
 using namespace Eigen;
 
 // --------------------------------------------- TEST CASES ---------------------------------------------
 
-TEST(BeamformerPath, Interface)
+TEST(BeamformerPath, Interface) { EXPECT_TRUE(InterfaceTests::algorithmInterfaceTest<BeamformerPath>()); }
+
+// description: process a number of frames and get the profile tree
+// pass/fail: with ALGORITHM_LIBRARY_PROFILING, the tree lists all member algorithms, each called once per frame, and the members take less time than the parent.
+// Without ALGORITHM_LIBRARY_PROFILING, the tree is empty
+TEST(BeamformerPath, ProfileTree)
+{
+    BeamformerPath path;
+    auto input = path.initInput();
+    auto output = path.initOutput(input);
+    const int nFrames = 20;
+    for (auto frame = 0; frame < nFrames; frame++)
+    {
+        path.process(input, output);
+    }
+    nlohmann::json tree = path.getProfileTree();
+    fmt::print("profile tree: {}\n", tree.dump(4));
+
+#ifdef ALGORITHM_LIBRARY_PROFILING
+    EXPECT_EQ(tree["calls"].get<int>(), nFrames);
+    double membersMicroseconds = 0;
+    for (auto member : {"filterbank", "filterbankInverse", "beamformer", "activityDetector", "dcRemover"})
+    {
+        ASSERT_TRUE(tree["members"].contains(member));
+        EXPECT_EQ(tree["members"][member]["calls"].get<int>(), nFrames);
+        membersMicroseconds += tree["members"][member]["totalMicroseconds"].get<double>();
+    }
+    EXPECT_LT(membersMicroseconds, tree["totalMicroseconds"].get<double>());
+#else
+    EXPECT_TRUE(tree.empty());
+#endif
+}
+
+// description: trace a number of frames to a Chrome trace file from the test thread, from a registered thread that exits during the trace, and from a thread that is not
+// registered
+// pass/fail: with ALGORITHM_LIBRARY_TRACING, the file has one event per frame for BeamformerPath and its filterbanks in each registered thread, and the filterbank
+// events are inside the BeamformerPath events of the same thread. The thread that is not registered is not traced, the buffer of the thread that has exited is freed,
+// and the first call to process() in each thread doesn't allocate memory. Without ALGORITHM_LIBRARY_TRACING, a trace can't be started and threads can't be registered
+TEST(BeamformerPath, Trace)
 {
-    bool testMallocFlag = false;
-    EXPECT_TRUE(InterfaceTests::algorithmInterfaceTest<BeamformerPath>(testMallocFlag));
+    const std::string filename = "beamformer_path_trace.json";
+    const int nFrames = 20;
+    int nAllocations = 0;
+    auto processFrames = [&](bool registerThread) {
+        if (registerThread) { Tracing::registerThread(); }
+        BeamformerPath path;
+        auto input = path.initInput();
+        auto output = path.initOutput(input);
+        InterfaceTests::startAllocationCounter();
+        path.process(input, output);
+        nAllocations += InterfaceTests::stopAllocationCounter();
+        for (auto frame = 1; frame < nFrames; frame++)
+        {
+            path.process(input, output);
+        }
+    };
+
+#ifdef ALGORITHM_LIBRARY_TRACING
+    ASSERT_TRUE(Tracing::registerThread());
+    const size_t nBuffers = Tracing::getRegistry().getBuffers().size();
+    ASSERT_TRUE(Tracing::start(filename));
+    EXPECT_FALSE(Tracing::start(filename)); // a trace is already running
+    processFrames(false); // the test thread is registered
+    std::thread threadRegistered(processFrames, true);
+    threadRegistered.join();
+    std::thread threadNotRegistered(processFrames, false);
+    threadNotRegistered.join();
+    Tracing::stop();
+    EXPECT_EQ(Tracing::getRegistry().getBuffers().size(), nBuffers);
+    EXPECT_EQ(nAllocations, 0);
+
+    std::ifstream file(filename);
+    nlohmann::json trace = nlohmann::json::parse(file);
+    file.close();
+    std::remove(filename.c_str());
+
+    struct Interval
+    {
+        int threadId;
+        double start, end;
+    };
+    std::vector<Interval> parents;
+    std::vector<Interval> filterbanks;
+    std::set<int> threadIds, namedThreadIds;
+    for (auto &event : trace["traceEvents"])
+    {
+        const int threadId = event["tid"].get<int>();
+        if (event["ph"] == "M") { namedThreadIds.insert(threadId); }
+        if (event["ph"] != "X") { continue; }
+        const double start = event["ts"].get<double>();
+        const double end = start + event["dur"].get<double>();
+        if (event["name"] == "BeamformerPath")
+        {
+            parents.push_back({threadId, start, end});
+            threadIds.insert(threadId);
+        }
+        else if (event["name"] == "FilterbankAnalysisWOLA" || event["name"] == "FilterbankSynthesisWOLA") { filterbanks.push_back({threadId, start, end}); }
+    }
+    EXPECT_EQ(static_cast<int>(parents.size()), 2 * nFrames);
+    EXPECT_EQ(static_cast<int>(filterbanks.size()), 4 * nFrames);
+    EXPECT_EQ(threadIds.size(), 2u);
+    EXPECT_EQ(namedThreadIds, threadIds);
+    for (auto &filterbank : filterbanks)
+    {
+        bool nested = false;
+        for (auto &parent : parents)
+        {
+            nested |= filterbank.threadId == parent.threadId && filterbank.start >= parent.start - 1e-3 && filterbank.end <= parent.end + 1e-3;
+        }
+        EXPECT_TRUE(nested);
+    }
+#else
+    EXPECT_FALSE(Tracing::registerThread());
+    EXPECT_FALSE(Tracing::start(filename));
+    processFrames(true);
+#endif
 }
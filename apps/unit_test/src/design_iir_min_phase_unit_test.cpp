@@ -6,11 +6,7 @@ using namespace Eigen;
 
 // --------------------------------------------- TEST CASES ---------------------------------------------
 
-TEST(DesignIIRMinPhase, Interface)
-{
-    bool testMallocFlag = false;
-    EXPECT_TRUE(InterfaceTests::algorithmInterfaceTest<DesignIIRMinPhaseTF2SOS>(testMallocFlag));
-}
+TEST(DesignIIRMinPhase, Interface) { EXPECT_TRUE(InterfaceTests::algorithmInterfaceTest<DesignIIRMinPhaseTF2SOS>()); }
 
 TEST(DesignIIRMinPhase, CheckCalculation)
 {
@@ -6,8 +6,4 @@ using namespace Eigen;
 
 // --------------------------------------------- TEST CASES ---------------------------------------------
 
-TEST(DesignIIRNonParametric, Interface)
-{
-    bool testMallocFlag = false;
-    EXPECT_TRUE(InterfaceTests::algorithmInterfaceTest<DesignIIRSpline>(testMallocFlag));
-}
+TEST(DesignIIRNonParametric, Interface) { EXPECT_TRUE(InterfaceTests::algorithmInterfaceTest<DesignIIRSpline>()); }
@@ -48,6 +48,52 @@ TEST(FFTReal, Reconstruction)
     EXPECT_LT(error, 1e-9f);
 }
 
+// description: run FFT on multiple channels with output that has nBands rows and output padded to an even number of rows, where all channels are 16 byte aligned
+// pass/fail: the outputs are identical
+TEST(FFTReal, PaddedOutput)
+{
+    auto c = FFTReal::Coefficients();
+    FFTReal fft(c);
+    const int nChannels = 5;
+    const int nBands = FFTConfiguration::convertFFTSizeToNBands(c.fftSize);
+    const int nBandsPadded = FFTConfiguration::convertFFTSizeToNBandsPadded(c.fftSize);
+    EXPECT_EQ(nBandsPadded % 2, 0);
+
+    ArrayXXf input(c.fftSize, nChannels);
+    input.setRandom();
+    ArrayXXcf output(nBands, nChannels);
+    ArrayXXcf outputPadded(nBandsPadded, nChannels);
+    fft.process(input, output);
+    fft.process(input, outputPadded.topRows(nBands));
+
+    float error = (output - outputPadded.topRows(nBands)).abs2().sum();
+    fmt::print("Difference between contiguous and padded output: {}\n", error);
+    EXPECT_EQ(error, 0.f);
+}
+
+// description: create several FFTs with the same size and check they share the FFT setup, while an FFT with a different size has its own setup
+// pass/fail: the shared memory of each instance is split between the instances using the same setup
+TEST(FFTReal, SharedSetup)
+{
+    auto c = FFTReal::Coefficients();
+    FFTReal fft1(c);
+    const size_t sharedSize = fft1.getSharedDynamicSize();
+    fmt::print("Shared memory size with 1 instance: {}\n", sharedSize);
+    EXPECT_GT(sharedSize, 0u);
+    {
+        FFTReal fft2(c);
+        FFTReal fft3 = fft2;
+        fmt::print("Shared memory size with 3 instances: {}\n", fft1.getSharedDynamicSize());
+        EXPECT_EQ(fft1.getSharedDynamicSize(), sharedSize / 3);
+        EXPECT_EQ(fft2.getSharedDynamicSize(), fft1.getSharedDynamicSize());
+
+        c.fftSize = 2 * c.fftSize;
+        FFTReal fft4(c);
+        EXPECT_GT(fft4.getSharedDynamicSize(), sharedSize); // not shared with the other instances
+    }
+    EXPECT_EQ(fft1.getSharedDynamicSize(), sharedSize);
+}
+
 // description: choose FFT size and check it is valid
 TEST(FFTReal, getValidFFTSize)
 {
@@ -67,12 +113,12 @@ TEST(FFTReal, getValidFFTSize)
     EXPECT_TRUE(fftSizeValid == 1152);
 }
 
-// description: Choose an invalid FFT size and check FFT correctly detects it
-// pass/fail: The FFT detects invalid size and throws exception
+// description: Choose an invalid FFT size and check FFT correctly detects it. Then choose sizes that are not supported natively by pffft and check they are valid
+// pass/fail: The FFT detects invalid size and throws exception and doesn't throw exception for valid sizes
 TEST(FFTReal, InvalidFFTSize)
 {
-    // set fftSize to 1023 (invalid size)
-    int fftSize = 1023; // invalid FFT size;
+    // set fftSize to 1 (invalid size)
+    int fftSize = 1; // invalid FFT size;
     bool isValid = FFTConfiguration::isFFTSizeValid(fftSize);
     EXPECT_FALSE(isValid);
 
@@ -90,12 +136,12 @@ TEST(FFTReal, InvalidFFTSize)
     }
     EXPECT_FALSE(validFFTSize);
 
-    // set fftSize to 33 (invalid size)
+    // set fftSize to 0 (invalid size)
     FFTReal fft;
     validFFTSize = true;
     try
     {
-        c.fftSize = 33;
+        c.fftSize = 0;
         fft.setCoefficients(c);
     }
     catch (const FFTReal::Configuration::ExceptionFFT &error)
@@ -105,47 +151,67 @@ TEST(FFTReal, InvalidFFTSize)
     }
     EXPECT_FALSE(validFFTSize);
 
-    // set fftSize to 1760 (invalid size)
-    validFFTSize = true;
-    try
-    {
-        c.fftSize = 1760;
-        fft.setCoefficients(c);
-    }
-    catch (const FFTReal::Configuration::ExceptionFFT &error)
+    // sizes not supported by pffft are calculated using Bluestein's algorithm and are valid
+    for (auto size : {1023, 33, 1760, 16, 128})
     {
-        fmt::print("Caught exception: {}\n", error.what());
-        validFFTSize = false;
+        EXPECT_TRUE(FFTConfiguration::isFFTSizeValid(size));
+        validFFTSize = true;
+        try
+        {
+            c.fftSize = size;
+            fft.setCoefficients(c);
+        }
+        catch (const FFTReal::Configuration::ExceptionFFT &error)
+        {
+            fmt::print("Caught exception: {}\n", error.what());
+            validFFTSize = false;
+        }
+        EXPECT_TRUE(validFFTSize);
     }
-    EXPECT_FALSE(validFFTSize);
+}
 
-    // set fftSize to 16 (invalid size)
-    validFFTSize = true;
-    try
-    {
-        c.fftSize = 16;
-        fft.setCoefficients(c);
-    }
-    catch (const FFTReal::Configuration::ExceptionFFT &error)
+// description: run FFT with sizes that are not supported natively by pffft and compare to a direct DFT calculation. Then invert and check reconstruction
+// pass/fail: error compared to DFT and reconstruction error are below thresholds
+TEST(FFTReal, ArbitrarySize)
+{
+    for (auto fftSize : {2, 3, 16, 33, 441, 882, 1023, 1760})
     {
-        fmt::print("Caught exception: {}\n", error.what());
-        validFFTSize = false;
+        auto c = FFTReal::Coefficients();
+        c.fftSize = fftSize;
+        FFTReal fft(c);
+        ArrayXf input = ArrayXf::Random(fftSize);
+        ArrayXcf output = fft.initOutput(input);
+        fft.process(input, output);
+
+        // direct DFT calculation in double precision
+        const int nBands = FFTConfiguration::convertFFTSizeToNBands(fftSize);
+        ArrayXcd outputDFT(nBands);
+        for (auto k = 0; k < nBands; k++)
+        {
+            const ArrayXd phase = ArrayXd::LinSpaced(fftSize, 0, fftSize - 1) * (-2 * 3.141592653589793 * k / fftSize);
+            outputDFT(k) = std::complex<double>((input.cast<double>() * phase.cos()).sum(), (input.cast<double>() * phase.sin()).sum());
+        }
+        float errorDFT = static_cast<float>((output.cast<std::complex<double>>() - outputDFT).abs2().sum() / outputDFT.abs2().sum());
+
+        ArrayXf inputRef = input;
+        input.setRandom(); // randomize input in case inverse doesn't write to input
+        fft.inverse(output, input);
+        float error = (input - inputRef).abs2().sum() / inputRef.abs2().sum();
+        fmt::print("FFT size = {0}: Relative error compared to DFT: {1}, relative reconstruction error: {2}\n", fftSize, errorDFT, error);
+
+        EXPECT_LT(errorDFT, 1e-9f);
+        EXPECT_LT(error, 1e-9f);
     }
-    EXPECT_FALSE(validFFTSize);
+}
 
-    // set fftSize to 128 (valid size)
-    validFFTSize = true;
-    try
-    {
-        c.fftSize = 128;
-        fft.setCoefficients(c);
-    }
-    catch (const FFTReal::Configuration::ExceptionFFT &error)
-    {
-        fmt::print("Caught exception: {}\n", error.what());
-        validFFTSize = false;
-    }
-    EXPECT_TRUE(validFFTSize);
+// description: run interface test with an FFT size that is calculated using Bluestein's algorithm
+TEST(FFTReal, InterfaceBluestein)
+{
+    auto c = FFTReal::Coefficients();
+    c.fftSize = 882;
+    EXPECT_TRUE(InterfaceTests::algorithmInterfaceTest<FFTReal>(c));
+    c.fftSize = 441;
+    EXPECT_TRUE(InterfaceTests::algorithmInterfaceTest<FFTReal>(c));
 }
 
 TEST(FFTReal, SIMDEnabled)
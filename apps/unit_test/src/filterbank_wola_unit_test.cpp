@@ -1,5 +1,6 @@
-#include "filterbank/filterbank_wola.h"
+#include "filterbank/filterbank_processor.h"
 #include "filterbank/filterbank_single_channel.h"
+#include "filterbank/filterbank_wola.h"
 #include "unit_test.h"
 #include "gtest/gtest.h"
 using namespace Eigen;
@@ -14,6 +15,8 @@ TEST(Filterbank, InterfaceSingleChannelAnalysis) { EXPECT_TRUE(InterfaceTests::a
 
 TEST(Filterbank, InterfaceSingleChannelSynthesis) { EXPECT_TRUE(InterfaceTests::algorithmInterfaceTest<FilterbankSynthesisSingleChannel>()); }
 
+TEST(Filterbank, InterfaceProcessor) { EXPECT_TRUE(InterfaceTests::algorithmInterfaceTest<FilterbankProcessor>()); }
+
 // Description: Send random signal through HighQuality filterbank and reconstruct it.
 // pass/fail: check reconstruction error is below threshold.
 TEST(Filterbank, ReconstructionHighQuality)
@@ -114,4 +117,111 @@ TEST(Filterbank, ReconstructionStandard)
 
     fmt::print("Output error: {}\n", error);
     EXPECT_LT(error, 1e-6f);
-}
\ No newline at end of file
+}
+
+// Description: Send random signal through LowDelay filterbank and reconstruct it for different ratios between FFT size and buffer size and for both single and
+// multichannel implementations.
+// pass/fail: check reconstruction error is below threshold and that the delay is bufferSize independent of FFT size.
+TEST(Filterbank, ReconstructionLowDelay)
+{
+    const int nFrames = 100; // number of frames to process
+
+    for (auto nChannels : {1, 2})
+    {
+        for (auto factor : {2, 4, 8})
+        {
+            auto c = FilterbankAnalysis::Coefficients();
+            c.nChannels = nChannels;
+            c.filterbankType = c.LOW_DELAY;
+            c.nBands = FFTConfiguration::convertFFTSizeToNBands(factor * c.bufferSize);
+            FilterbankAnalysis filterbank(c);
+            FilterbankSynthesis filterbankInv(c);
+
+            ArrayXXf input(nFrames * c.bufferSize, c.nChannels);
+            input.setRandom();
+            ArrayXXf output(nFrames * c.bufferSize, c.nChannels);
+
+            auto outFreq = filterbank.initOutput(input.topRows(c.bufferSize));
+            for (auto i = 0; i < nFrames; i++)
+            {
+                filterbank.process(input.middleRows(i * c.bufferSize, c.bufferSize), outFreq);
+                filterbankInv.process(outFreq, output.middleRows(i * c.bufferSize, c.bufferSize));
+            }
+            int offset = c.bufferSize; // synthesis window length - bufferSize = 2 * bufferSize - bufferSize
+            float error = (input.topRows(nFrames * c.bufferSize - offset) - output.bottomRows(nFrames * c.bufferSize - offset)).abs2().mean();
+            error /= input.topRows(nFrames * c.bufferSize - offset).abs2().mean();
+
+            fmt::print("nChannels: {}, fftSize / bufferSize: {}, output error: {}\n", nChannels, factor, error);
+            EXPECT_LT(error, 1e-10f);
+        }
+    }
+}
+
+// Description: Measure the delay of an impulse through analysis and synthesis filterbanks.
+// pass/fail: check the measured delay plus bufferSize is within one sample of the sum of getDelaySamples() of the analysis and synthesis filterbanks.
+TEST(Filterbank, MeasureDelay)
+{
+    for (auto filterbankType : {FilterbankConfiguration::Coefficients::HANN, FilterbankConfiguration::Coefficients::WOLA, FilterbankConfiguration::Coefficients::LOW_DELAY})
+    {
+        auto c = FilterbankAnalysis::Coefficients();
+        c.filterbankType = filterbankType;
+        c.nBands = FFTConfiguration::convertFFTSizeToNBands(4 * c.bufferSize);
+        FilterbankAnalysis filterbank(c);
+        FilterbankSynthesis filterbankInv(c);
+
+        const int nFrames = 10;
+        ArrayXXf input = ArrayXXf::Zero(nFrames * c.bufferSize, c.nChannels);
+        input(0, 0) = 1.f;
+        ArrayXXf output(nFrames * c.bufferSize, c.nChannels);
+        auto outFreq = filterbank.initOutput(input.topRows(c.bufferSize));
+        for (auto i = 0; i < nFrames; i++)
+        {
+            filterbank.process(input.middleRows(i * c.bufferSize, c.bufferSize), outFreq);
+            filterbankInv.process(outFreq, output.middleRows(i * c.bufferSize, c.bufferSize));
+        }
+        Index delay;
+        output.col(0).abs().maxCoeff(&delay);
+        const float delayExpected = filterbank.getDelaySamples() + filterbankInv.getDelaySamples() - c.bufferSize;
+
+        fmt::print("Filterbank type: {}, measured delay: {}, expected delay: {}\n", static_cast<int>(filterbankType), delay, delayExpected);
+        EXPECT_NEAR(static_cast<float>(delay), delayExpected, 1.f);
+    }
+}
+
+// Description: Apply a channel dependent gain to a random signal using FilterbankProcessor and compare to separate analysis and synthesis filterbanks.
+// pass/fail: check difference is below threshold.
+TEST(Filterbank, ProcessorCompareToAnalysisSynthesis)
+{
+    const int nFrames = 100; // number of frames to process
+
+    for (auto filterbankType : {FilterbankConfiguration::Coefficients::HANN, FilterbankConfiguration::Coefficients::WOLA, FilterbankConfiguration::Coefficients::LOW_DELAY})
+    {
+        auto c = FilterbankProcessor::Coefficients();
+        c.nChannels = 3;
+        c.filterbankType = filterbankType;
+        c.nBands = FFTConfiguration::convertFFTSizeToNBands(4 * c.bufferSize);
+        FilterbankProcessor processor(c);
+        FilterbankAnalysisWOLA filterbank(c);
+        FilterbankSynthesisWOLA filterbankInv(c);
+
+        ArrayXXf gain = ArrayXXf::Random(c.nBands, c.nChannels);
+        ArrayXXf input = ArrayXXf::Random(nFrames * c.bufferSize, c.nChannels);
+        ArrayXXf output(nFrames * c.bufferSize, c.nChannels);
+        ArrayXXf outputRef(nFrames * c.bufferSize, c.nChannels);
+        ArrayXXcf outFreq = filterbank.initOutput(input.topRows(c.bufferSize));
+        for (auto i = 0; i < nFrames; i++)
+        {
+            processor.process(input.middleRows(i * c.bufferSize, c.bufferSize), output.middleRows(i * c.bufferSize, c.bufferSize),
+                              [&](ArrayXcf &xFreq, int channel) { xFreq *= gain.col(channel); });
+
+            filterbank.process(input.middleRows(i * c.bufferSize, c.bufferSize), outFreq);
+            outFreq *= gain;
+            filterbankInv.process(outFreq, outputRef.middleRows(i * c.bufferSize, c.bufferSize));
+        }
+        float error = (output - outputRef).abs2().mean() / outputRef.abs2().mean();
+
+        fmt::print("Output error: {}\n", error);
+        EXPECT_LT(error, 1e-10f);
+        EXPECT_EQ(processor.getDelaySamples(), filterbank.getDelaySamples() + filterbankInv.getDelaySamples());
+    }
+}
@@ -0,0 +1,96 @@
+#include "fir_filter/fir_filter_partitioned.h"
+#include "fir_filter/fir_filter_time_domain.h"
+#include "unit_test.h"
+#include "gtest/gtest.h"
+
+using namespace Eigen;
+
+// --------------------------------------------- TEST CASES ---------------------------------------------
+
+TEST(FIRFilter, InterfaceTimeDomain)
+{
+    auto c = FIRFilterTimeDomain::Coefficients();
+    c.filterLength = 16;
+    EXPECT_TRUE(InterfaceTests::algorithmInterfaceTest<FIRFilterTimeDomain>(c));
+}
+
+TEST(FIRFilter, InterfacePartitioned) { EXPECT_TRUE(InterfaceTests::algorithmInterfaceTest<FIRFilterPartitioned>()); }
+
+// calculate FIR filter output using direct convolution
+static ArrayXXf convolve(const ArrayXXf &input, const ArrayXf &filter)
+{
+    ArrayXXf output = ArrayXXf::Zero(input.rows(), input.cols());
+    for (auto sample = 0; sample < input.rows(); sample++)
+    {
+        for (auto i = 0; i <= std::min(sample, static_cast<int>(filter.size()) - 1); i++)
+        {
+            output.row(sample) += filter(i) * input.row(sample - i);
+        }
+    }
+    return output;
+}
+
+// run FIR filter on consecutive buffers and return output
+template <typename Talgo>
+ArrayXXf filterSignal(Talgo &algo, const ArrayXXf &input)
+{
+    const int bufferSize = algo.getCoefficients().bufferSize;
+    ArrayXXf output(input.rows(), input.cols());
+    for (auto i = 0; i < input.rows() / bufferSize; i++)
+    {
+        algo.process(input.middleRows(i * bufferSize, bufferSize), output.middleRows(i * bufferSize, bufferSize));
+    }
+    return output;
+}
+
+// description: filter a random signal with random filters of different lengths and buffer sizes and compare to direct convolution
+// pass/fail: the relative error of both implementations is below a threshold
+TEST(FIRFilter, CompareToConvolution)
+{
+    for (auto bufferSize : {64, 100})
+    {
+        for (auto filterLength : {1, 16, 100, 1024})
+        {
+            auto c = FIRFilterPartitioned::Coefficients();
+            c.bufferSize = bufferSize;
+            c.filterLength = filterLength;
+            FIRFilterTimeDomain filterTimeDomain(c);
+            FIRFilterPartitioned filterPartitioned(c);
+
+            ArrayXf filter = ArrayXf::Random(filterLength - filterLength / 4); // filter is shorter than filterLength
+            filterTimeDomain.setFilter(filter);
+            filterPartitioned.setFilter(filter);
+
+            ArrayXXf input = ArrayXXf::Random(20 * bufferSize, c.nChannels);
+            ArrayXXf outputRef = convolve(input, filterTimeDomain.getFilter());
+            ArrayXXf outputTimeDomain = filterSignal(filterTimeDomain, input);
+            ArrayXXf outputPartitioned = filterSignal(filterPartitioned, input);
+
+            float errorTimeDomain = (outputTimeDomain - outputRef).abs2().sum() / outputRef.abs2().sum();
+            float errorPartitioned = (outputPartitioned - outputRef).abs2().sum() / outputRef.abs2().sum();
+            fmt::print("bufferSize = {}, filterLength = {}: Relative error time domain: {}, relative error partitioned: {}\n", bufferSize, filterLength, errorTimeDomain,
+                       errorPartitioned);
+            EXPECT_LT(errorTimeDomain, 1e-10f);
+            EXPECT_LT(errorPartitioned, 1e-10f);
+        }
+    }
+}
+
+// description: check public FIRFilter selects implementation based on filterLength and that setFilter and getFilter match
+TEST(FIRFilter, PublicSetFilter)
+{
+    for (auto filterLength : {FIRFilterConfiguration::FILTER_LENGTH_TIME_DOMAIN_MAX, 1000})
+    {
+        FIRFilter filter({.nChannels = 1, .bufferSize = 128, .filterLength = filterLength});
+        ArrayXf h = ArrayXf::Random(filterLength);
+        filter.setFilter(h);
+        EXPECT_TRUE(filter.getFilter().isApprox(h));
+
+        ArrayXXf input = ArrayXXf::Zero(128, 1);
+        input(0) = 1.f;
+        ArrayXXf output = filter.initOutput(input);
+        filter.process(input, output);
+        const int n = std::min(filterLength, 128);
+        EXPECT_TRUE(output.col(0).head(n).isApprox(h.head(n), 1e-5f)); // impulse response
+    }
+}
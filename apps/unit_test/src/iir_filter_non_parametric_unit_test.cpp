@@ -7,3 +7,21 @@ using namespace Eigen;
 // --------------------------------------------- TEST CASES ---------------------------------------------
 
 TEST(IIRFilterNonParametric, Interface) { EXPECT_TRUE(InterfaceTests::algorithmInterfaceTest<IIRFilterTDFNonParametric>()); }
+
+// description: set the filter of the TDF and SVF implementations with random gains
+// pass/fail: setFilter doesn't allocate heap memory, so it can be called from the processing thread
+TEST(IIRFilterNonParametric, SetFilterAllocationFree)
+{
+    IIRFilterTDFNonParametric filterTDF;
+    IIRFilterSVFNonParametric filterSVF;
+    const auto c = filterTDF.getCoefficients();
+    ArrayXf frequencies = ArrayXf::LinSpaced(c.nSos, std::log(0.005f * c.sampleRate), std::log(0.25f * c.sampleRate)).exp();
+    ArrayXf gaindB = ArrayXf::Random(c.nSos) * 20;
+
+    InterfaceTests::startAllocationCounter();
+    filterTDF.setFilter(frequencies, gaindB);
+    filterSVF.setFilter(frequencies, gaindB);
+    const int count = InterfaceTests::stopAllocationCounter();
+    if (count > 0) { InterfaceTests::printAllocationCallStack(); }
+    EXPECT_EQ(count, 0);
+}
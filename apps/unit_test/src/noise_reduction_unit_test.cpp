@@ -1,7 +1,11 @@
 #include "noise_reduction/noise_reduction_apriori.h"
 #include "noise_reduction/noise_reduction_ml.h"
+#include "noise_reduction/noise_reduction_ml_async.h"
+#include "noise_reduction/noise_reduction_ml_native.h"
 #include "unit_test.h"
 #include "gtest/gtest.h"
+#include <fstream>
+#include <iterator>
 
 using namespace Eigen;
 
@@ -9,7 +13,24 @@ using namespace Eigen;
 
 TEST(NoiseReduction, InterfaceApriori) { EXPECT_TRUE(InterfaceTests::algorithmInterfaceTest<NoiseReductionAPriori>()); }
 
-TEST(NoiseReduction, InterfaceML) { EXPECT_TRUE(InterfaceTests::algorithmInterfaceTest<NoiseReductionML>()); }
+// ONNX Runtime allocates memory in every call to Session::Run, so only Eigen allocations are tested
+TEST(NoiseReduction, InterfaceML)
+{
+    bool testMallocFlag = false;
+    EXPECT_TRUE(InterfaceTests::algorithmInterfaceTest<NoiseReductionML>(testMallocFlag));
+    EXPECT_TRUE(InterfaceTests::mallocDEBUGTest<NoiseReductionML>());
+}
+
+TEST(NoiseReduction, InterfaceMLNative) { EXPECT_TRUE(InterfaceTests::algorithmInterfaceTest<NoiseReductionMLNative>()); }
+
+TEST(NoiseReduction, InterfaceMLNativeInt8)
+{
+    NoiseReductionMLNative::Coefficients c;
+    c.algorithmType = c.ML_NATIVE_INT8;
+    EXPECT_TRUE(InterfaceTests::algorithmInterfaceTest<NoiseReductionMLNative>(c));
+}
+
+TEST(NoiseReduction, InterfaceMLAsync) { EXPECT_TRUE(InterfaceTests::algorithmInterfaceTest<NoiseReductionMLAsync>()); }
 
 // test the ML noise reduction can be run
 TEST(NoiseReduction, MLRun)
@@ -20,4 +41,135 @@ TEST(NoiseReduction, MLRun)
     auto output = noiseReduction.initOutput(input);
 
     noiseReduction.process(input, output);
-}
\ No newline at end of file
+}
+
+// description: run the ML noise reduction on the same input before and after reset. The recurrent states are ping-ponged inside the model
+// pass/fail: the outputs are equal
+TEST(NoiseReduction, MLReset)
+{
+    NoiseReductionML noiseReduction;
+    const int nFrames = 5;
+    ArrayXXcf input = ArrayXXcf::Random(257, nFrames);
+    ArrayXXcf output(257, nFrames), outputReset(257, nFrames);
+    for (auto frame = 0; frame < nFrames; frame++)
+    {
+        noiseReduction.process(input.col(frame), output.col(frame));
+    }
+    noiseReduction.reset();
+    for (auto frame = 0; frame < nFrames; frame++)
+    {
+        noiseReduction.process(input.col(frame), outputReset.col(frame));
+    }
+    EXPECT_TRUE(output.isApprox(outputReset));
+}
+
+// description: run the ML noise reduction with several channels and compare to running a single channel instance for each channel
+// pass/fail: the outputs are equal, since each channel has its own recurrent states
+TEST(NoiseReduction, MLMultiChannel)
+{
+    const int nChannels = 3;
+    const int nFrames = 5;
+    NoiseReductionML noiseReduction({.nBands = 257, .nChannels = nChannels, .algorithmType = NoiseReductionConfiguration::Coefficients::ML});
+    std::vector<NoiseReductionML> noiseReductionChannels(nChannels);
+    ArrayXXcf output(257, nChannels), outputChannel(257, 1);
+    float error = 0.f;
+    for (auto frame = 0; frame < nFrames; frame++)
+    {
+        ArrayXXcf input = ArrayXXcf::Random(257, nChannels);
+        noiseReduction.process(input, output);
+        for (auto channel = 0; channel < nChannels; channel++)
+        {
+            noiseReductionChannels[channel].process(input.col(channel), outputChannel);
+            error += (output.col(channel) - outputChannel).abs2().sum();
+        }
+    }
+    fmt::print("Error between multi-channel and single channel outputs: {}\n", error);
+    EXPECT_EQ(error, 0.f);
+}
+
+// description: run the native and the ONNX Runtime implementation of the ML noise reduction with several channels on the same input
+// pass/fail: the relative error between the outputs is below a threshold
+TEST(NoiseReduction, MLNativeCompareToML)
+{
+    const int nChannels = 2;
+    const int nFrames = 20;
+    NoiseReductionML noiseReduction({.nBands = 257, .nChannels = nChannels, .algorithmType = NoiseReductionConfiguration::Coefficients::ML});
+    NoiseReductionMLNative noiseReductionNative({.nBands = 257, .nChannels = nChannels, .algorithmType = NoiseReductionConfiguration::Coefficients::ML_NATIVE});
+    ArrayXXcf output(257, nChannels), outputNative(257, nChannels);
+    float error = 0.f, power = 0.f;
+    for (auto frame = 0; frame < nFrames; frame++)
+    {
+        ArrayXXcf input = ArrayXXcf::Random(257, nChannels);
+        noiseReduction.process(input, output);
+        noiseReductionNative.process(input, outputNative);
+        error += (output - outputNative).abs2().sum();
+        power += output.abs2().sum();
+    }
+    fmt::print("Relative error between native and ONNX Runtime output: {}\n", error / power);
+    EXPECT_LT(error / power, 1e-8f);
+}
+
+// description: run the native ML noise reduction with int8 and float weights with several channels on the same input
+// pass/fail: the relative error between the outputs is below a threshold
+TEST(NoiseReduction, MLNativeInt8CompareToFloat)
+{
+    const int nChannels = 2;
+    const int nFrames = 20;
+    NoiseReductionMLNative noiseReduction({.nBands = 257, .nChannels = nChannels, .algorithmType = NoiseReductionConfiguration::Coefficients::ML_NATIVE});
+    NoiseReductionMLNative noiseReductionInt8({.nBands = 257, .nChannels = nChannels, .algorithmType = NoiseReductionConfiguration::Coefficients::ML_NATIVE_INT8});
+    ArrayXXcf output(257, nChannels), outputInt8(257, nChannels);
+    float error = 0.f, power = 0.f;
+    for (auto frame = 0; frame < nFrames; frame++)
+    {
+        ArrayXXcf input = ArrayXXcf::Random(257, nChannels);
+        noiseReduction.process(input, output);
+        noiseReductionInt8.process(input, outputInt8);
+        error += (output - outputInt8).abs2().sum();
+        power += output.abs2().sum();
+    }
+    fmt::print("Relative error between int8 and float weights: {} dB\n", 10 * std::log10(error / power));
+    EXPECT_LT(error / power, 1e-3f);
+}
+
+// description: set the model directory to a directory without the model and create the native ML noise reduction. Then register the model from memory
+// pass/fail: the model is not found in the directory, and it is found when it is registered, so the native implementation looks up models like ONNXModel
+TEST(NoiseReduction, MLNativeModelLookup)
+{
+    ONNXModel::setModelDirectory("directory_without_models");
+    EXPECT_THROW(NoiseReductionMLNative(), std::runtime_error);
+
+    // the registered buffer must stay valid while the model can be created, so it is static
+    std::ifstream file("pp2model.onnx", std::ios::binary);
+    static const std::vector<char> buffer((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    ONNXModel::registerModel("pp2model.onnx", buffer.data(), buffer.size());
+    EXPECT_NO_THROW(NoiseReductionMLNative());
+    ONNXModel::setModelDirectory("");
+}
+
+// description: run the asynchronous and synchronous ML noise reduction with several channels on the same input, and wait for the inference after each frame
+// pass/fail: the asynchronous output is equal to the synchronous output of the previous frame and there are no deadline misses
+TEST(NoiseReduction, MLAsyncCompareToSync)
+{
+    const int nChannels = 2;
+    const int nFrames = 20;
+    NoiseReductionMLNative noiseReduction({.nBands = 257, .nChannels = nChannels, .algorithmType = NoiseReductionConfiguration::Coefficients::ML_NATIVE});
+    NoiseReductionMLAsync noiseReductionAsync({.nBands = 257,
+                                               .nChannels = nChannels,
+                                               .algorithmType = NoiseReductionConfiguration::Coefficients::ML_NATIVE,
+                                               .inferenceMode = NoiseReductionConfiguration::Coefficients::ASYNCHRONOUS});
+    EXPECT_EQ(NoiseReductionConfiguration::getDelayFrames(noiseReductionAsync.getCoefficients()), 1);
+    ArrayXXcf output(257, nChannels), outputPrevious = ArrayXXcf::Zero(257, nChannels), outputAsync(257, nChannels);
+    float error = 0.f;
+    for (auto frame = 0; frame < nFrames; frame++)
+    {
+        ArrayXXcf input = ArrayXXcf::Random(257, nChannels);
+        noiseReduction.process(input, output);
+        noiseReductionAsync.process(input, outputAsync);
+        noiseReductionAsync.waitForInference();
+        error += (outputAsync - outputPrevious).abs2().sum();
+        outputPrevious = output;
+    }
+    fmt::print("Error between asynchronous output and delayed synchronous output: {}\n", error);
+    EXPECT_EQ(error, 0.f);
+    EXPECT_EQ(noiseReductionAsync.getDeadlineMisses(), 0);
+}
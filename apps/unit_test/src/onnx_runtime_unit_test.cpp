@@ -2,7 +2,11 @@
 #include "onnxruntime_run_options_config_keys.h"
 #include "onnxruntime_session_options_config_keys.h"
 #include "unit_test.h"
+#include "utilities/onnx_model.h"
 #include "gtest/gtest.h"
+#include <fstream>
+#include <iterator>
+#include <vector>
 
 // startup environment with verbose logging level
 TEST(ONNXRUNTIME, EnvironmentStartup)
@@ -14,24 +18,11 @@ TEST(ONNXRUNTIME, EnvironmentStartup)
     fmt::print("static size of environment: {} bytes\n", sizeof(env));
 }
 
-// test that the session can be created with global threads and shared allocator
+// test that the session can be created with global threads and shared allocator. The environment is the one shared by all ONNXModels, since the allocator can only
+// be registered once per process
 TEST(ONNXRUNTIME, SessionWithGlobalThreadOptions)
 {
-    Ort::ThreadingOptions threadOptions;
-    threadOptions.SetGlobalInterOpNumThreads(2);
-    Ort::Env env(threadOptions, ORT_LOGGING_LEVEL_WARNING, "test");
-
-    // shared memory allocator inspired from: https://github.com/microsoft/onnxruntime/blob/main/onnxruntime/test/shared_lib/test_inference.cc
-    Ort::MemoryInfo memInfo = Ort::MemoryInfo::CreateCpu(OrtArenaAllocator, OrtMemTypeDefault);
-
-    size_t maxMemory = 0;           // 0 = default
-    int arenaExtendStrategy = -1;   // -1 = default
-    int initialChunkSizeBytes = -1; // -1 = default
-    int maxDeadBytesPerChunk = -1;  // -1 = default
-    Ort::ArenaCfg arenaCfg = Ort::ArenaCfg(maxMemory, arenaExtendStrategy, initialChunkSizeBytes, maxDeadBytesPerChunk);
-
-    env.CreateAndRegisterAllocator(memInfo, arenaCfg);
-    env.DisableTelemetryEvents();
+    Ort::Env &env = ONNXModel::getEnvironment();
 
     Ort::SessionOptions sessionOptions;
     sessionOptions.SetGraphOptimizationLevel(GraphOptimizationLevel::ORT_ENABLE_EXTENDED);
@@ -116,18 +107,7 @@ TEST(ONNXRUNTIME, RunMLModel)
 
     Ort::MemoryInfo mem_info = Ort::MemoryInfo::CreateCpu(OrtAllocatorType::OrtArenaAllocator, OrtMemType::OrtMemTypeDefault);
 
-    size_t maxMemory = 0;           // 0 = default
-    int arenaExtendStrategy = -1;   // -1 = default
-    int initialChunkSizeBytes = -1; // -1 = default
-    int maxDeadBytesPerChunk = -1;  // -1 = default
-    Ort::ArenaCfg arenaCfg = Ort::ArenaCfg(maxMemory, arenaExtendStrategy, initialChunkSizeBytes, maxDeadBytesPerChunk);
-
-    Ort::ThreadingOptions threadOptions;
-    threadOptions.SetGlobalInterOpNumThreads(2);
-    Ort::Env env(threadOptions, ORT_LOGGING_LEVEL_WARNING, "global_environment");
-
-    env.CreateAndRegisterAllocator(mem_info, arenaCfg);
-    env.DisableTelemetryEvents();
+    Ort::Env &env = ONNXModel::getEnvironment(); // global threads and shared allocator
 
     Ort::SessionOptions sessionOptions;
     sessionOptions.SetGraphOptimizationLevel(GraphOptimizationLevel::ORT_ENABLE_EXTENDED);
@@ -188,4 +168,79 @@ TEST(ONNXRUNTIME, RunMLModel)
     std::cout << "processing\n" << std::endl;
     outputTensors = session.Run(Ort::RunOptions{nullptr}, inputNamesChar.data(), inputTensors.data(), inputNamesChar.size(), outputNamesChar.data(), outputNamesChar.size());
     std::cout << "processing done!\n" << std::endl;
-}
\ No newline at end of file
+}
+
+// description: bind input and output buffers of the identity model.onnx to ONNXModel and run it
+// pass/fail: the output buffer is written directly by the model and equals the input buffer
+TEST(ONNXRUNTIME, ONNXModelBoundBuffers)
+{
+    ONNXModel model("model.onnx", {"modelInput"}, {{1, 1, 1}}, {"modelOutput"}, {{1, 1, 1}});
+    Eigen::ArrayXf input(1), output(1);
+    model.setInput(0, input);
+    model.setOutput(0, output);
+    for (auto i = 0; i < 3; i++)
+    {
+        input(0) = static_cast<float>(i) + 0.5f;
+        model.run();
+        EXPECT_EQ(output(0), input(0));
+    }
+}
+
+// description: create several ONNXModels of the same file and run them
+// pass/fail: models with the same file and options share a single session, and each model writes to its own output
+TEST(ONNXRUNTIME, ONNXModelSharedSession)
+{
+    ONNXModel model1("model.onnx", {"modelInput"}, {{1, 1, 1}}, {"modelOutput"}, {{1, 1, 1}});
+    ONNXModel model2("model.onnx", {"modelInput"}, {{1, 1, 1}}, {"modelOutput"}, {{1, 1, 1}});
+    ONNXModel model3("model.onnx", {"modelInput"}, {{1, 1, 1}}, {"modelOutput"}, {{1, 1, 1}}, GraphOptimizationLevel::ORT_ENABLE_BASIC);
+    EXPECT_EQ(model1.getSession(), model2.getSession());
+    EXPECT_NE(model1.getSession(), model3.getSession());
+
+    // each model has its own buffers
+    Eigen::ArrayXf input1(1), output1(1), input2(1), output2(1);
+    model1.setInput(0, input1);
+    model1.setOutput(0, output1);
+    model2.setInput(0, input2);
+    model2.setOutput(0, output2);
+    input1(0) = 1.f;
+    input2(0) = 2.f;
+    model1.run();
+    model2.run();
+    EXPECT_EQ(output1(0), 1.f);
+    EXPECT_EQ(output2(0), 2.f);
+}
+
+// description: register the identity model.onnx from a buffer in memory and run it
+// pass/fail: the model is created from the buffer and the output equals the input
+TEST(ONNXRUNTIME, ONNXModelFromMemory)
+{
+    std::ifstream file("model.onnx", std::ios::binary);
+    const std::vector<char> buffer((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    ONNXModel::registerModel("model_in_memory", buffer.data(), buffer.size());
+    ONNXModel model("model_in_memory", {"modelInput"}, {{1, 1, 1}}, {"modelOutput"}, {{1, 1, 1}});
+    Eigen::ArrayXf input(1), output(1);
+    model.setInput(0, input);
+    model.setOutput(0, output);
+    input(0) = 1.5f;
+    model.run();
+    EXPECT_EQ(output(0), input(0));
+}
+
+// description: create the identity model.onnx twice with the optimized graph cache in the working directory. The session is released between the two, so the
+// first model saves the optimized graph and the second loads it
+// pass/fail: both models give an output equal to the input
+TEST(ONNXRUNTIME, ONNXModelOptimizedCache)
+{
+    ONNXModel::setOptimizedModelDirectory(".");
+    for (auto i = 0; i < 2; i++)
+    {
+        ONNXModel model("model.onnx", {"modelInput"}, {{1, 1, 1}}, {"modelOutput"}, {{1, 1, 1}});
+        Eigen::ArrayXf input(1), output(1);
+        model.setInput(0, input);
+        model.setOutput(0, output);
+        input(0) = static_cast<float>(i) + 0.5f;
+        model.run();
+        EXPECT_EQ(output(0), input(0));
+    }
+    ONNXModel::setOptimizedModelDirectory("");
+}
@@ -6,11 +6,7 @@ using namespace Eigen;
 
 // --------------------------------------------- TEST CASES ---------------------------------------------
 
-TEST(PreprocessingPath, Interface)
-{
-    bool testMallocFlag = false;
-    EXPECT_TRUE(InterfaceTests::algorithmInterfaceTest<BeamformerPath>(testMallocFlag));
-}
+TEST(PreprocessingPath, Interface) { EXPECT_TRUE(InterfaceTests::algorithmInterfaceTest<BeamformerPath>()); }
 
 TEST(PreprocessingPath, PublicInterface)
 {
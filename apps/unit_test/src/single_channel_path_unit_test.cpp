@@ -7,3 +7,33 @@ using namespace Eigen;
 // --------------------------------------------- TEST CASES ---------------------------------------------
 
 TEST(SingleChannelPath, Interface) { EXPECT_TRUE(InterfaceTests::algorithmInterfaceTest<NoiseReductionPath>()); }
+
+// description: process a number of frames and get the profile tree
+// pass/fail: with ALGORITHM_LIBRARY_PROFILING, the tree lists all member algorithms, each called once per frame. The noise reduction is called from the spectral
+// function of the filterbank, so it takes less time than the filterbank, which takes less time than the parent. Without ALGORITHM_LIBRARY_PROFILING, the tree is empty
+TEST(SingleChannelPath, ProfileTree)
+{
+    NoiseReductionPath path;
+    auto input = path.initInput();
+    auto output = path.initOutput(input);
+    const int nFrames = 20;
+    for (auto frame = 0; frame < nFrames; frame++)
+    {
+        path.process(input, output);
+    }
+    nlohmann::json tree = path.getProfileTree();
+    fmt::print("profile tree: {}\n", tree.dump(4));
+
+#ifdef ALGORITHM_LIBRARY_PROFILING
+    EXPECT_EQ(tree["calls"].get<int>(), nFrames);
+    for (auto member : {"filterbank", "noiseReduction", "dcRemover"})
+    {
+        ASSERT_TRUE(tree["members"].contains(member));
+        EXPECT_EQ(tree["members"][member]["calls"].get<int>(), nFrames);
+    }
+    EXPECT_LT(tree["members"]["noiseReduction"]["totalMicroseconds"].get<double>(), tree["members"]["filterbank"]["totalMicroseconds"].get<double>());
+    EXPECT_LT(tree["members"]["filterbank"]["totalMicroseconds"].get<double>(), tree["totalMicroseconds"].get<double>());
+#else
+    EXPECT_TRUE(tree.empty());
+#endif
+}
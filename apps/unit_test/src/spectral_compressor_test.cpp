@@ -10,6 +10,32 @@ using namespace Eigen;
 
 TEST(SpectralCompressor, Interface) { EXPECT_TRUE(InterfaceTests::algorithmInterfaceTest<SpectralCompressorWOLA>()); }
 
+// description: process a number of frames and get the profile tree
+// pass/fail: with ALGORITHM_LIBRARY_PROFILING, the filterbank is listed as a member and called once per frame, and it takes less time than the parent. Without
+// ALGORITHM_LIBRARY_PROFILING, the tree is empty
+TEST(SpectralCompressor, ProfileTree)
+{
+    SpectralCompressorWOLA compressor;
+    auto input = compressor.initInput();
+    auto output = compressor.initOutput(input);
+    const int nFrames = 20;
+    for (auto frame = 0; frame < nFrames; frame++)
+    {
+        compressor.process(input, output);
+    }
+    nlohmann::json tree = compressor.getProfileTree();
+    fmt::print("profile tree: {}\n", tree.dump(4));
+
+#ifdef ALGORITHM_LIBRARY_PROFILING
+    EXPECT_EQ(tree["calls"].get<int>(), nFrames);
+    ASSERT_TRUE(tree["members"].contains("filterbank"));
+    EXPECT_EQ(tree["members"]["filterbank"]["calls"].get<int>(), nFrames);
+    EXPECT_LT(tree["members"]["filterbank"]["totalMicroseconds"].get<double>(), tree["totalMicroseconds"].get<double>());
+#else
+    EXPECT_TRUE(tree.empty());
+#endif
+}
+
 TEST(SpectralSelector, Interface) { EXPECT_TRUE(InterfaceTests::algorithmInterfaceTest<SpectralSelector>()); }
 
 TEST(SpectralCompressorAdaptive, Interface) { EXPECT_TRUE(InterfaceTests::algorithmInterfaceTest<SpectralCompressorAdaptive>()); }
@@ -0,0 +1,75 @@
+#include "spectrogram/spectrogram_nonlinear.h"
+#include "spectrogram/spectrogram_nonlinear_kernel.h"
+#include "unit_test.h"
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <vector>
+
+using namespace Eigen;
+
+// --------------------------------------------- TEST CASES ---------------------------------------------
+
+TEST(SpectrogramNonlinearKernel, Interface) { EXPECT_TRUE(InterfaceTests::algorithmInterfaceTest<SpectrogramNonlinearKernel>()); }
+
+// description: calculate spectrogram of a signal with noise, tones and clicks using SpectrogramNonlinearKernel and SpectrogramNonlinear for different sizes and
+// compare them bin by bin in dB
+// pass/fail: bins within 20 dB of the maximum of their frame have an error below 3 dB. The median error of all bins is below 1.5 dB and the 90th percentile is
+// below 8 dB. Weak bins are dominated by leakage from the truncated kernels and since the minimum power is selected, their errors are larger
+TEST(SpectrogramNonlinearKernel, CompareToNonlinear)
+{
+    for (auto nBands : {1025, 257})
+    {
+        const int bufferSize = nBands - 1;
+        SpectrogramNonlinear spectrogramReference({.bufferSize = bufferSize, .nBands = nBands, .algorithmType = SpectrogramConfiguration::Coefficients::ADAPTIVE_HANN_8});
+        SpectrogramNonlinearKernel spectrogram({.bufferSize = bufferSize, .nBands = nBands, .algorithmType = SpectrogramConfiguration::Coefficients::ADAPTIVE_HANN_8_KERNEL});
+        const int nFrames = 20;
+        const int nFramesWarmup = 2; // frames before the full-length window is filled with signal
+
+        ArrayXf signal = 0.01f * ArrayXf::Random(nFrames * bufferSize);
+        signal += (ArrayXf::LinSpaced(signal.size(), 0, 0.05f * signal.size())).sin();
+        signal += 0.1f * (ArrayXf::LinSpaced(signal.size(), 0, 1.3f * signal.size())).sin();
+        for (auto i = 0; i < signal.size(); i += 1500)
+        {
+            signal(i) += 5.f;
+        }
+
+        ArrayXXf output(nBands, 8), outputReference(nBands, 8);
+        std::vector<float> errors;
+        float errorStrongMax = 0.f;
+        for (auto frame = 0; frame < nFrames; frame++)
+        {
+            spectrogram.process(signal.segment(frame * bufferSize, bufferSize), output);
+            spectrogramReference.process(signal.segment(frame * bufferSize, bufferSize), outputReference);
+            if (frame < nFramesWarmup) { continue; }
+
+            ArrayXXf errordB = (10.f * (output / outputReference).log10()).abs();
+            errors.insert(errors.end(), errordB.data(), errordB.data() + errordB.size());
+            for (auto col = 0; col < outputReference.cols(); col++)
+            {
+                const float threshold = 1e-2f * outputReference.col(col).maxCoeff(); // 20 dB below maximum
+                errorStrongMax = std::max(errorStrongMax, (outputReference.col(col) > threshold).select(errordB.col(col), 0.f).maxCoeff());
+            }
+        }
+        std::sort(errors.begin(), errors.end());
+        const float errorMedian = errors[errors.size() / 2];
+        const float error90 = errors[errors.size() * 9 / 10];
+        fmt::print("nBands = {}: Max error of strong bins: {} dB, median error: {} dB, 90th percentile error: {} dB\n", nBands, errorStrongMax, errorMedian, error90);
+        EXPECT_LT(errorStrongMax, 3.f);
+        EXPECT_LT(errorMedian, 1.5f);
+        EXPECT_LT(error90, 8.f);
+    }
+}
+
+// description: set a buffer size that doesn't give an integer number of sub-frames per FFT frame
+// pass/fail: the configuration is invalid
+TEST(SpectrogramNonlinearKernel, InvalidBufferSize)
+{
+    SpectrogramNonlinearKernel spectrogram({.bufferSize = 1000, .nBands = 1025, .algorithmType = SpectrogramConfiguration::Coefficients::ADAPTIVE_HANN_8_KERNEL});
+    EXPECT_FALSE(spectrogram.isConfigurationValid());
+
+    spectrogram.setCoefficients({.bufferSize = 1020, .nBands = 1025, .algorithmType = SpectrogramConfiguration::Coefficients::ADAPTIVE_HANN_8_KERNEL});
+    EXPECT_FALSE(spectrogram.isConfigurationValid()); // multiple of 8, but the sub-frame size doesn't divide the FFT size
+
+    spectrogram.setCoefficients({.bufferSize = 512, .nBands = 1025, .algorithmType = SpectrogramConfiguration::Coefficients::ADAPTIVE_HANN_8_KERNEL});
+    EXPECT_TRUE(spectrogram.isConfigurationValid());
+}
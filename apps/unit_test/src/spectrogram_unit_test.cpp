@@ -0,0 +1,46 @@
+#include "algorithm_library/spectrogram.h"
+#include "unit_test.h"
+#include "gtest/gtest.h"
+
+using namespace Eigen;
+
+// --------------------------------------------- TEST CASES ---------------------------------------------
+
+// description: calculate spectrogram of a random signal with processFrames using different number of threads and compare to calling process on consecutive buffers
+// pass/fail: the spectrograms are identical
+TEST(Spectrogram, ProcessFrames)
+{
+    using Coefficients = SpectrogramConfiguration::Coefficients;
+    for (auto algorithmType : {Coefficients::HANN, Coefficients::WOLA, Coefficients::ADAPTIVE_HANN_8, Coefficients::ADAPTIVE_WOLA_8, Coefficients::ADAPTIVE_HANN_8_KERNEL})
+    {
+        Spectrogram spectrogram({.bufferSize = 128, .nBands = 257, .algorithmType = algorithmType});
+        const int nFramesPerBuffer = SpectrogramConfiguration::getNFramesPerBuffer(spectrogram.getCoefficients());
+        const int nBuffers = 50;
+        ArrayXf signal = ArrayXf::Random(nBuffers * 128 + 100); // trailing samples are ignored
+
+        ArrayXXf outputReference(257, nBuffers * nFramesPerBuffer);
+        for (auto buffer = 0; buffer < nBuffers; buffer++)
+        {
+            spectrogram.process(signal.segment(buffer * 128, 128), outputReference.middleCols(buffer * nFramesPerBuffer, nFramesPerBuffer));
+        }
+
+        for (auto nThreads : {1, 3, 4})
+        {
+            ArrayXXf output(257, spectrogram.getNFrames(static_cast<int>(signal.size())));
+            spectrogram.processFrames(signal, output, nThreads);
+            float error = (output - outputReference).abs().maxCoeff();
+            fmt::print("algorithmType = {}, nThreads = {}: Max error: {}\n", static_cast<int>(algorithmType), nThreads, error);
+            EXPECT_EQ(error, 0.f);
+        }
+    }
+}
+
+// description: call processFrames with an output of the wrong size
+// pass/fail: an exception is thrown
+TEST(Spectrogram, ProcessFramesWrongSize)
+{
+    Spectrogram spectrogram;
+    ArrayXf signal = ArrayXf::Random(10 * spectrogram.getCoefficients().bufferSize);
+    ArrayXXf output(spectrogram.getCoefficients().nBands, spectrogram.getNFrames(static_cast<int>(signal.size())) + 1);
+    EXPECT_THROW(spectrogram.processFrames(signal, output), SpectrogramConfiguration::ExceptionSpectrogramFrames);
+}
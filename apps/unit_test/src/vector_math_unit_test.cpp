@@ -0,0 +1,117 @@
+#include "unit_test.h"
+#include "utilities/vector_math.h"
+#include "gtest/gtest.h"
+using namespace Eigen;
+
+// --------------------------------------------- TEST CASES ---------------------------------------------
+
+// the number of rows is not a multiple of the SIMD size, so both the vectorized and the scalar version of the functions are tested
+
+// description: calculate exp, exp2 and dB2lin and compare to double precision
+// pass/fail: the relative errors are within the documented bounds
+TEST(VectorMath, Exp)
+{
+    ArrayXXf x = ArrayXXf::Random(1001, 3) * 87.f;
+    ArrayXXf y(1001, 3);
+    VectorMath::exp(x, y);
+    float error = static_cast<float>(((y.cast<double>() - x.cast<double>().exp()) / x.cast<double>().exp()).abs().maxCoeff());
+    fmt::print("exp relative error: {}\n", error);
+    EXPECT_LT(error, 3e-7f);
+
+    x *= 126.f / 87.f;
+    VectorMath::exp2(x, y);
+    error = static_cast<float>(((y.cast<double>() - (x.cast<double>() * std::log(2.)).exp()) / (x.cast<double>() * std::log(2.)).exp()).abs().maxCoeff());
+    fmt::print("exp2 relative error: {}\n", error);
+    EXPECT_LT(error, 3e-7f);
+
+    x = ArrayXXf::Random(1001, 3) * 100.f;
+    VectorMath::dB2lin(x, y);
+    ArrayXXd reference = (x.cast<double>() * std::log(10.) / 20.).exp();
+    error = static_cast<float>(((y.cast<double>() - reference) / reference).abs().maxCoeff());
+    fmt::print("dB2lin relative error: {}\n", error);
+    EXPECT_LT(error, 3e-7f + 1e-8f * 100.f);
+}
+
+// description: calculate log, log2, energy2dB and pow of positive numbers with a large range and compare to double precision
+// pass/fail: the errors are within the documented bounds
+TEST(VectorMath, Log)
+{
+    ArrayXXf x = (ArrayXXf::Random(1001, 3) * 80.f).exp();
+    ArrayXXd xDouble = x.cast<double>();
+    ArrayXXf y(1001, 3);
+    VectorMath::log(x, y);
+    float error = static_cast<float>(((y.cast<double>() - xDouble.log()) / xDouble.log().abs().max(1.)).abs().maxCoeff());
+    fmt::print("log error: {}\n", error);
+    EXPECT_LT(error, 3.5e-7f);
+
+    VectorMath::log2(x, y);
+    error = static_cast<float>(((y.cast<double>() - xDouble.log2()) / xDouble.log2().abs().max(1.)).abs().maxCoeff());
+    fmt::print("log2 error: {}\n", error);
+    EXPECT_LT(error, 3.5e-7f);
+
+    VectorMath::energy2dB(x, y);
+    error = static_cast<float>(((y.cast<double>() - 10. * xDouble.log10()) / (10. * xDouble.log10()).abs().max(1.)).abs().maxCoeff());
+    fmt::print("energy2dB error: {}\n", error);
+    EXPECT_LT(error, 3.5e-7f);
+
+    x = ArrayXXf::Random(1001, 3).abs() * 100.f + 0.01f;
+    const float p = 2.5f;
+    VectorMath::pow(x, p, y);
+    ArrayXXd reference = x.cast<double>().pow(p);
+    error = static_cast<float>(((y.cast<double>() - reference) / reference / (1. + (p * x.cast<double>().log2()).abs())).abs().maxCoeff());
+    fmt::print("pow relative error divided by 1 + |p * log2(x)|: {}\n", error);
+    EXPECT_LT(error, 2e-7f);
+}
+
+// description: calculate sin and cos for |x| < 1000 and compare to double precision
+// pass/fail: the absolute errors are within the documented bound
+TEST(VectorMath, SinCos)
+{
+    ArrayXXf x = ArrayXXf::Random(1001, 3) * 1000.f;
+    ArrayXXf s(1001, 3), c(1001, 3);
+    VectorMath::sincos(x, s, c);
+    float errorSin = static_cast<float>((s.cast<double>() - x.cast<double>().sin()).abs().maxCoeff());
+    float errorCos = static_cast<float>((c.cast<double>() - x.cast<double>().cos()).abs().maxCoeff());
+    fmt::print("sin absolute error: {}, cos absolute error: {}\n", errorSin, errorCos);
+    EXPECT_LT(errorSin, 1.2e-7f);
+    EXPECT_LT(errorCos, 1.2e-7f);
+}
+
+// description: calculate atan2 for all quadrants including zeros, and the angle of complex numbers, and compare to double precision
+// pass/fail: the absolute errors are within the documented bound and atan2(0, 0) is 0
+TEST(VectorMath, Atan2)
+{
+    ArrayXXf x = ArrayXXf::Random(1001, 3) * 10.f;
+    ArrayXXf y = ArrayXXf::Random(1001, 3) * 10.f;
+    x(0, 0) = 0.f;
+    y(0, 0) = 0.f;
+    x(1, 0) = 0.f;
+    y(2, 0) = 0.f;
+    ArrayXXf angle(1001, 3);
+    VectorMath::atan2(y, x, angle);
+    ArrayXXd reference = y.cast<double>().binaryExpr(x.cast<double>(), [](double a, double b) { return std::atan2(a, b); });
+    float error = static_cast<float>((angle.cast<double>() - reference).abs().maxCoeff());
+    fmt::print("atan2 absolute error: {}\n", error);
+    EXPECT_LT(error, 3.5e-7f);
+    EXPECT_EQ(angle(0, 0), 0.f);
+
+    ArrayXXcf z = ArrayXXcf::Random(257, 2);
+    ArrayXXf phase(257, 2);
+    VectorMath::arg(z, phase);
+    reference = z.cast<std::complex<double>>().arg();
+    error = static_cast<float>((phase.cast<double>() - reference).abs().maxCoeff());
+    fmt::print("arg absolute error: {}\n", error);
+    EXPECT_LT(error, 3.5e-7f);
+}
+
+// description: calculate the complex exponential in place and compare to double precision
+// pass/fail: the relative error is below 1e-6
+TEST(VectorMath, ExpComplex)
+{
+    ArrayXXcf x = ArrayXXcf::Random(257, 2) * 5.f;
+    ArrayXXcd reference = x.cast<std::complex<double>>().exp();
+    VectorMath::expComplex(x, x);
+    float error = static_cast<float>(((x.cast<std::complex<double>>() - reference).abs() / reference.abs()).maxCoeff());
+    fmt::print("complex exponential relative error: {}\n", error);
+    EXPECT_LT(error, 1e-6f);
+}
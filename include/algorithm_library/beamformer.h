@@ -20,7 +20,10 @@ struct BeamformerConfiguration
         int nChannels = 4;
         float filterbankRate = 125.f;
         int nBands = 257;
-        DEFINE_TUNABLE_COEFFICIENTS(nChannels, filterbankRate, nBands)
+        enum BeamformerTypes { EIGEN_DECOMPOSITION, RECURSIVE_INVERSE };
+        BeamformerTypes beamformerType = EIGEN_DECOMPOSITION; // RECURSIVE_INVERSE updates the filters in all bands every frame
+        DEFINE_TUNABLE_ENUM(BeamformerTypes, {{EIGEN_DECOMPOSITION, "Eigen Decomposition"}, {RECURSIVE_INVERSE, "Recursive Inverse"}})
+        DEFINE_TUNABLE_COEFFICIENTS(nChannels, filterbankRate, nBands, beamformerType)
     };
 
     struct Parameters
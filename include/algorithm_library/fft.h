@@ -4,9 +4,13 @@
 // Real version of an FFT.
 //
 // This class has a public inverse FFT function.
-// Supported FFT sizes are multiples of 32 and FFT class has public isFFTSizeValid() method.
+// Any FFT size larger than 1 is supported. getValidFFTSize() returns the nearest size that is calculated natively by pffft. Other sizes use Bluestein's algorithm,
+// which is a few times slower.
 // NOTE: This class will throw an exception if FFT size is not supported.
 //
+// The FFT writes directly to output channels that are 16 byte aligned. For multichannel output allocate convertFFTSizeToNBandsPadded(fftSize) rows and pass the top
+// convertFFTSizeToNBands(fftSize) rows to process(), so every channel is aligned and no intermediate copy is needed.
+//
 // author: Kristian Timm Andersen
 
 struct FFTConfiguration
@@ -27,9 +31,10 @@ struct FFTConfiguration
 
     static inline int convertNBandsToFFTSize(int nBands) { return (nBands - 1) * 2; }
     static inline int convertFFTSizeToNBands(int fftSize) { return fftSize / 2 + 1; }
+    static inline int convertFFTSizeToNBandsPadded(int fftSize) { return (convertFFTSizeToNBands(fftSize) + 1) / 2 * 2; } // even number of bands so all channels are 16 byte aligned
 
     static bool isFFTSizeValid(const int fftSize);
-    static int getValidFFTSize(const int fftSize); // return valid fftSize that is equal or greater than fftSize
+    static int getValidFFTSize(const int fftSize); // return fftSize that is equal or greater than fftSize and calculated natively (fastest)
 
     static Eigen::ArrayXXf initInput(const Coefficients &c) { return Eigen::ArrayXXf::Random(c.fftSize, 2); } // time samples. Number of channels is arbitrary
 
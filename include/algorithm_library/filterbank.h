@@ -9,6 +9,9 @@
 // Similarly, if nChannels = 1, the input to FilerbankSynthesis will have the size nBands x nFrames, where nFrames corresponds to the same definition
 // of FilterbankAnalysis and the output size will be (bufferSize * nFrames) x 1.
 //
+// The LOW_DELAY filterbank type uses asymmetric analysis and synthesis windows, where the synthesis window only covers the last 2 * bufferSize samples of the analysis
+// window. The delay through analysis and synthesis is then bufferSize samples independent of nBands, compared to fftSize - bufferSize samples for the HANN type.
+//
 // author: Kristian Timm Andersen
 
 struct FilterbankConfiguration
@@ -18,9 +21,9 @@ struct FilterbankConfiguration
         int nChannels = 2;
         int bufferSize = 128;
         int nBands = 257;
-        enum FilterbankTypes { HANN, SQRT_HANN, WOLA, USER_DEFINED };
+        enum FilterbankTypes { HANN, SQRT_HANN, WOLA, USER_DEFINED, LOW_DELAY }; // new types are appended, so the values of existing types are unchanged
         FilterbankTypes filterbankType = HANN;
-        DEFINE_TUNABLE_ENUM(FilterbankTypes, {{HANN, "Hann"}, {SQRT_HANN, "Sqrt Hann"}, {WOLA, "Wola"}, {USER_DEFINED, "User Defined"}})
+        DEFINE_TUNABLE_ENUM(FilterbankTypes, {{HANN, "Hann"}, {SQRT_HANN, "Sqrt Hann"}, {WOLA, "Wola"}, {USER_DEFINED, "User Defined"}, {LOW_DELAY, "Low Delay"}})
         DEFINE_TUNABLE_COEFFICIENTS(nChannels, bufferSize, nBands, filterbankType)
     };
 
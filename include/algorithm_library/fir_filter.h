@@ -0,0 +1,54 @@
+#pragma once
+#include "interface/interface.h"
+
+// FIR filter
+//
+// The same filter is applied to all channels. The filter is set with setFilter() and can be shorter than filterLength, in which case it is zero padded.
+// The default filter is a unit impulse.
+//
+// Short filters are calculated directly in the time domain and long filters are calculated with uniformly partitioned overlap-save convolution in the frequency domain.
+// Both implementations are free of latency, since the partition size equals bufferSize.
+//
+// author: Kristian Timm Andersen
+
+struct FIRFilterConfiguration
+{
+    using Input = I::Real2D;
+    using Output = O::Real2D;
+
+    struct Coefficients
+    {
+        int nChannels = 2;
+        int bufferSize = 128;
+        int filterLength = 1024;
+        DEFINE_TUNABLE_COEFFICIENTS(nChannels, bufferSize, filterLength)
+    };
+
+    struct Parameters
+    {
+        DEFINE_NO_TUNABLE_PARAMETERS
+    };
+
+    // filters up to this length are calculated in the time domain. Found with FIRFilter_process benchmarks at bufferSize = 128
+    static constexpr int FILTER_LENGTH_TIME_DOMAIN_MAX = 16;
+
+    static Eigen::ArrayXXf initInput(const Coefficients &c) { return Eigen::ArrayXXf::Random(c.bufferSize, c.nChannels); } // time samples
+
+    static Eigen::ArrayXXf initOutput(Input input, const Coefficients &c) { return Eigen::ArrayXXf::Zero(c.bufferSize, c.nChannels); } // time samples
+
+    static bool validInput(Input input, const Coefficients &c) { return (input.rows() == c.bufferSize) && (input.cols() == c.nChannels) && input.allFinite(); }
+
+    static bool validOutput(Output output, const Coefficients &c) { return (output.rows() == c.bufferSize) && (output.cols() == c.nChannels) && output.allFinite(); }
+};
+
+class FIRFilter : public Algorithm<FIRFilterConfiguration>
+{
+  public:
+    FIRFilter() = default;
+    FIRFilter(const Coefficients &c);
+
+    // set filter. Filter length must be less than or equal to filterLength
+    void setFilter(I::Real filter);
+
+    Eigen::ArrayXf getFilter() const;
+};
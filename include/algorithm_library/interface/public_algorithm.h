@@ -56,6 +56,9 @@ class Algorithm
     nlohmann::json getDebugJson() const { return pimpl->getDebugJson(); }
     void setDebugJson(const nlohmann::json &s) { pimpl->setDebugJson(s); }
 
+    // timings of process() in the implementation and its member algorithms. Empty unless the library is built with ALGORITHM_LIBRARY_PROFILING
+    nlohmann::json getProfileTree() const { return pimpl->getProfileTree(); }
+
     auto validInput(Input input) const { return pimpl->validInput(input); }
     auto validOutput(Output output) const { return pimpl->validOutput(output); }
     auto initInput() const { return pimpl->initInput(); }
@@ -79,6 +82,7 @@ class Algorithm
         virtual void reset() = 0;
         virtual nlohmann::json getDebugJson() const = 0;
         virtual void setDebugJson(const nlohmann::json &s) = 0;
+        virtual nlohmann::json getProfileTree() const = 0;
         virtual bool isConfigurationValid() const = 0;
         virtual bool validInput(typename Configuration::Input input) const = 0;
         virtual bool validOutput(typename Configuration::Output output) const = 0;
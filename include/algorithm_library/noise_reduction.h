@@ -11,10 +11,17 @@ struct NoiseReductionConfiguration
         int nBands = 257;
         int nChannels = 2;
         float filterbankRate = 125.f;
-        enum NoiseReductionType { APRIORI, ML };
+        // ML_NATIVE is the ML model implemented without ONNX Runtime, and ML_NATIVE_INT8 is the same with int8 weights
+        enum NoiseReductionType { APRIORI, ML, ML_NATIVE, ML_NATIVE_INT8 };
         NoiseReductionType algorithmType = APRIORI; // choose algorithm to use for calculating Noise reduction
-        DEFINE_TUNABLE_ENUM(NoiseReductionType, {{APRIORI, "Apriori SNR"}, {ML, "Machine Learning"}})
-        DEFINE_TUNABLE_COEFFICIENTS(nBands, nChannels, filterbankRate, algorithmType);
+        DEFINE_TUNABLE_ENUM(NoiseReductionType, {{APRIORI, "Apriori SNR"}, {ML, "Machine Learning"}, {ML_NATIVE, "Machine Learning Native"},
+                                                 {ML_NATIVE_INT8, "Machine Learning Native Int8"}})
+        // ASYNCHRONOUS runs the ML model on a worker thread and applies the gain of a frame to the output of the next call to process, which delays the output
+        // by 1 frame (see getDelayFrames). It is only used by the ML types
+        enum InferenceMode { SYNCHRONOUS, ASYNCHRONOUS };
+        InferenceMode inferenceMode = SYNCHRONOUS;
+        DEFINE_TUNABLE_ENUM(InferenceMode, {{SYNCHRONOUS, "Synchronous"}, {ASYNCHRONOUS, "Asynchronous"}})
+        DEFINE_TUNABLE_COEFFICIENTS(nBands, nChannels, filterbankRate, algorithmType, inferenceMode);
     };
 
     struct Parameters
@@ -32,6 +39,9 @@ struct NoiseReductionConfiguration
     static bool validInput(Input input, const Coefficients &c) { return (input.rows() == c.nBands) && (input.cols() == c.nChannels) && input.allFinite(); }
 
     static bool validOutput(Output output, const Coefficients &c) { return (output.rows() == c.nBands) && (output.cols() == c.nChannels) && output.allFinite(); }
+
+    // return number of frames the output is delayed compared to the input
+    static int getDelayFrames(const Coefficients &c) { return ((c.inferenceMode == Coefficients::ASYNCHRONOUS) && (c.algorithmType != Coefficients::APRIORI)) ? 1 : 0; }
 };
 
 class NoiseReduction : public Algorithm<NoiseReductionConfiguration>
@@ -39,4 +49,6 @@ class NoiseReduction : public Algorithm<NoiseReductionConfiguration>
   public:
     NoiseReduction() = default;
     NoiseReduction(const Coefficients &c);
+
+    int getDelayFrames() const;
 };
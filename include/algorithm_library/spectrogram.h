@@ -1,8 +1,11 @@
 #pragma once
 #include "interface/interface.h"
+#include <functional>
 
 // spectrogram. Default windows is Hann window, and there is a method for setting a user defined window.
 //
+// processFrames() calculates the spectrogram of a whole signal offline using several threads, see Spectrogram below.
+//
 // author: Kristian Timm Andersen
 
 struct SpectrogramConfiguration
@@ -15,13 +18,16 @@ struct SpectrogramConfiguration
         int bufferSize = 1024; // input buffer size
         int nBands = 1025;     // number of frequency bands in output
         enum SpectrogramAlgorithmType {
-            HANN,            // Hann window with length of FFT size = 2 * (nBands - 1)
-            WOLA,            // Sinc modulated Kaiser window with length of 2 * FFTSize = 4 * (nBands - 1)
-            ADAPTIVE_HANN_8, // Hann window of adaptive length with max length of FFT size = 2 * (nBands - 1) and a min length of FFT size / 8
-            ADAPTIVE_WOLA_8  // WOLA window of adaptive length with a max length of 2 * FFTSize = 4 * (nBands - 1) and a min length of 2 * FFT size / 8
+            HANN,                   // Hann window with length of FFT size = 2 * (nBands - 1)
+            WOLA,                   // Sinc modulated Kaiser window with length of 2 * FFTSize = 4 * (nBands - 1)
+            ADAPTIVE_HANN_8,        // Hann window of adaptive length with max length of FFT size = 2 * (nBands - 1) and a min length of FFT size / 8
+            ADAPTIVE_WOLA_8,        // WOLA window of adaptive length with a max length of 2 * FFTSize = 4 * (nBands - 1) and a min length of 2 * FFT size / 8
+            ADAPTIVE_HANN_8_KERNEL  // adaptive Hann windows like ADAPTIVE_HANN_8, but the shorter windows are approximated from a single FFT with frequency-domain
+                                    // kernels. Accurate for bins within 20 dB of the frame maximum. bufferSize / 8 must divide the FFT size
         };
         SpectrogramAlgorithmType algorithmType = HANN; // choose algorithm to use for calculating spectrogram
-        DEFINE_TUNABLE_ENUM(SpectrogramAlgorithmType, {{HANN, "Hann"}, {WOLA, "Wola"}, {ADAPTIVE_HANN_8, "Adaptive x8"}, {ADAPTIVE_WOLA_8, "Adaptive Wola x8"}})
+        DEFINE_TUNABLE_ENUM(SpectrogramAlgorithmType, {{HANN, "Hann"}, {WOLA, "Wola"}, {ADAPTIVE_HANN_8, "Adaptive x8"}, {ADAPTIVE_WOLA_8, "Adaptive Wola x8"},
+                                                     {ADAPTIVE_HANN_8_KERNEL, "Adaptive x8 Kernel"}})
         DEFINE_TUNABLE_COEFFICIENTS(bufferSize, nBands, algorithmType)
     };
 
@@ -30,24 +36,42 @@ struct SpectrogramConfiguration
         DEFINE_NO_TUNABLE_PARAMETERS
     };
 
-    static int getValidFFTSize(int fftSize); // return valid FFT size larger or equal to fftSize
+    static int getValidFFTSize(int fftSize); // return FFT size larger or equal to fftSize that is calculated natively (fastest). Any other size is also valid
 
     static Eigen::ArrayXf initInput(const Coefficients &c) { return Eigen::ArrayXf::Random(c.bufferSize); } // time samples
 
-    static Eigen::ArrayXXf initOutput(Input input, const Coefficients &c) // power spectrogram
-    {
-        if ((c.algorithmType == Coefficients::ADAPTIVE_HANN_8) || (c.algorithmType == Coefficients::ADAPTIVE_WOLA_8)) { return Eigen::ArrayXXf::Zero(c.nBands, 8); }
-        return Eigen::ArrayXXf::Zero(c.nBands, 1);
-    }
+    static Eigen::ArrayXXf initOutput(Input input, const Coefficients &c) { return Eigen::ArrayXXf::Zero(c.nBands, getNFramesPerBuffer(c)); } // power spectrogram
 
     static bool validInput(Input input, const Coefficients &c) { return (input.rows() == c.bufferSize) && input.allFinite(); }
 
     static bool validOutput(Output output, const Coefficients &c)
     {
-        int nCols = 1;
-        if ((c.algorithmType == Coefficients::ADAPTIVE_HANN_8) || (c.algorithmType == Coefficients::ADAPTIVE_WOLA_8)) { nCols = 8; }
-        return (output.rows() == c.nBands) && output.allFinite() && (output >= 0).all() && (output.cols() == nCols);
+        return (output.rows() == c.nBands) && output.allFinite() && (output >= 0).all() && (output.cols() == getNFramesPerBuffer(c));
     }
+
+    // return number of output frames for each input buffer
+    static int getNFramesPerBuffer(const Coefficients &c)
+    {
+        if ((c.algorithmType == Coefficients::ADAPTIVE_HANN_8) || (c.algorithmType == Coefficients::ADAPTIVE_WOLA_8) ||
+            (c.algorithmType == Coefficients::ADAPTIVE_HANN_8_KERNEL))
+        {
+            return 8;
+        }
+        return 1;
+    }
+
+    // return number of output frames when processing nSamples with processFrames(). Trailing samples that don't fill a buffer are ignored
+    static int getNFrames(int nSamples, const Coefficients &c) { return (nSamples / c.bufferSize) * getNFramesPerBuffer(c); }
+
+    // exception for calling processFrames() with an output of the wrong size
+    class ExceptionSpectrogramFrames : public std::runtime_error
+    {
+      public:
+        ExceptionSpectrogramFrames(int nSamples, const Coefficients &c)
+            : std::runtime_error(std::string("\nOutput of processFrames must have ") + std::to_string(c.nBands) + " rows and " + std::to_string(getNFrames(nSamples, c)) +
+                                 " columns for " + std::to_string(nSamples) + " input samples\n")
+        {}
+    };
 };
 
 class Spectrogram : public Algorithm<SpectrogramConfiguration>
@@ -55,4 +79,18 @@ class Spectrogram : public Algorithm<SpectrogramConfiguration>
   public:
     Spectrogram() = default;
     Spectrogram(const Coefficients &c);
+
+    // function that writes samples.size() consecutive samples starting at startSample into samples. It is called from several threads at the same time
+    using SampleReader = std::function<void(int startSample, O::Real samples)>;
+
+    // Calculate the spectrogram of a whole signal offline. The buffers are split into one chunk per thread, and each chunk is calculated by its own Spectrogram
+    // instance that is first primed with the samples before the chunk, so the output is identical to calling process() on consecutive buffers after a reset().
+    // The state of this instance is not used or changed. The output must have nBands rows and getNFrames(nSamples) columns. If nThreads <= 0, the number of
+    // hardware threads is used.
+    void processFrames(I::Real input, O::Real2D output, int nThreads = 0) const;
+
+    // same as above, but samples are read in chunks with readSamples, so the whole signal doesn't have to be in memory (e.g. a memory-mapped file)
+    void processFrames(const SampleReader &readSamples, int nSamples, O::Real2D output, int nThreads = 0) const;
+
+    int getNFrames(int nSamples) const { return Configuration::getNFrames(nSamples, getCoefficients()); }
 };
@@ -0,0 +1,20 @@
+#pragma once
+#include <string>
+
+// Timeline tracing of process() in all algorithms for diagnosing deadline misses. While a trace is running, every call to process() in a registered thread, including the
+// calls to member algorithms, is written to a Chrome trace JSON file, which can be opened in Perfetto (ui.perfetto.dev) or chrome://tracing.
+//
+// Each processing thread must call registerThread() once before its calls to process() can be traced, e.g. when an audio thread starts. It allocates the event buffer of
+// the thread, so process() doesn't lock or allocate memory while a trace is running. The buffer is freed when the thread exits.
+//
+// Tracing is only available if the library is compiled with ALGORITHM_LIBRARY_TRACING (CMake option of the same name). Otherwise start() returns false and nothing is
+// recorded.
+//
+// author: Kristian Timm Andersen
+
+namespace Tracing
+{
+bool start(const std::string &filename); // start a trace. Returns false if tracing is not compiled in, a trace is already running or the file can't be opened
+void stop();                             // stop the running trace and finish writing the file
+bool registerThread();                   // register the calling thread, so its calls to process() are traced. Returns false if tracing is not compiled in
+} // namespace Tracing
@@ -0,0 +1,196 @@
+# Quantize the weights of an ONNX model to int8 with a scale for each output channel, while activations stay float.
+#
+# Each quantized weight W is replaced by the initializers W_quantized (int8), W_scale (float) and W_zero_point (int8, always 0) and a DequantizeLinear node that
+# outputs W, so the quantized model can still be run by ONNX Runtime. The native implementation in NoiseReductionMLNative reads W_quantized and W_scale directly
+# and keeps the weights as int8 in memory.
+#
+# The weights that are quantized are the weights of Conv (axis 0), MatMul (last axis) and GRU (axis 1). Biases, normalization weights and PReLU slopes are
+# small and are kept as float. The quantization is symmetric: scale = max(abs(W)) / 127 for each output channel.
+#
+# The script only uses the Python standard library, so it reads and writes the protobuf format directly.
+#
+# usage: python quantize_model.py pp2model.onnx pp2model_int8.onnx
+#
+# author: Kristian Timm Andersen
+import struct
+import sys
+
+# protobuf wire types and ONNX enums
+VARINT, FIXED64, LENGTH_DELIMITED, FIXED32 = 0, 1, 2, 5
+TENSOR_FLOAT, TENSOR_INT8 = 1, 3
+ATTRIBUTE_INT = 2
+QUANTIZED_INPUTS = {'Conv': {1: 0}, 'MatMul': {1: -1}, 'GRU': {1: 1, 2: 1}}  # op type -> {input index: channel axis}
+
+
+def read_varint(data, position):
+    value, shift = 0, 0
+    while True:
+        byte = data[position]
+        position += 1
+        value |= (byte & 0x7F) << shift
+        shift += 7
+        if byte < 0x80:
+            return value, position
+
+
+def parse(data):
+    """return list of (field number, wire type, value) where value is an int or bytes"""
+    fields, position = [], 0
+    while position < len(data):
+        key, position = read_varint(data, position)
+        number, wire_type = key >> 3, key & 7
+        if wire_type == VARINT:
+            value, position = read_varint(data, position)
+        elif wire_type == LENGTH_DELIMITED:
+            size, position = read_varint(data, position)
+            value, position = data[position:position + size], position + size
+        elif wire_type == FIXED32:
+            value, position = data[position:position + 4], position + 4
+        elif wire_type == FIXED64:
+            value, position = data[position:position + 8], position + 8
+        else:
+            raise ValueError('unsupported wire type %d' % wire_type)
+        fields.append((number, wire_type, value))
+    return fields
+
+
+def encode_varint(value):
+    if value < 0:
+        value += 1 << 64
+    out = bytearray()
+    while True:
+        byte = value & 0x7F
+        value >>= 7
+        if value:
+            out.append(byte | 0x80)
+        else:
+            out.append(byte)
+            return bytes(out)
+
+
+def encode(fields):
+    out = bytearray()
+    for number, wire_type, value in fields:
+        out += encode_varint((number << 3) | wire_type)
+        if wire_type == VARINT:
+            out += encode_varint(value)
+        elif wire_type == LENGTH_DELIMITED:
+            out += encode_varint(len(value)) + value
+        else:
+            out += value
+    return bytes(out)
+
+
+def get_fields(fields, number):
+    return [value for n, _, value in fields if n == number]
+
+
+def get_string(fields, number):
+    values = get_fields(fields, number)
+    return values[0].decode() if values else ''
+
+
+def read_tensor(data):
+    """return name, dims and values of a float tensor, or None if it is not a float tensor"""
+    fields = parse(data)
+    data_type = (get_fields(fields, 2) or [TENSOR_FLOAT])[0]
+    if data_type != TENSOR_FLOAT:
+        return None
+    dims = []
+    for value in get_fields(fields, 1):
+        if isinstance(value, int):
+            dims.append(value)
+        else:
+            dims += unpack_varints(value)
+    raw = get_fields(fields, 9)
+    if raw:
+        values = list(struct.unpack('<%df' % (len(raw[0]) // 4), raw[0]))
+    else:
+        values = []
+        for value in get_fields(fields, 4):
+            values += list(struct.unpack('<%df' % (len(value) // 4), value))
+    return get_string(fields, 8), dims, values
+
+
+def unpack_varints(data):
+    values, position = [], 0
+    while position < len(data):
+        value, position = read_varint(data, position)
+        values.append(value)
+    return values
+
+
+def write_tensor(name, dims, data_type, raw):
+    fields = [(1, VARINT, dim) for dim in dims]
+    fields += [(2, VARINT, data_type), (8, LENGTH_DELIMITED, name.encode()), (9, LENGTH_DELIMITED, raw)]
+    return encode(fields)
+
+
+def quantize(dims, values, axis):
+    """symmetric int8 quantization with a scale for each index along axis"""
+    axis %= len(dims)
+    n_channels = dims[axis]
+    inner = 1
+    for dim in dims[axis + 1:]:
+        inner *= dim
+    channel = lambda index: (index // inner) % n_channels
+    maximum = [0.0] * n_channels
+    for index, value in enumerate(values):
+        maximum[channel(index)] = max(maximum[channel(index)], abs(value))
+    scales = [m / 127.0 if m > 0 else 1.0 for m in maximum]
+    scales = [struct.unpack('<f', struct.pack('<f', scale))[0] for scale in scales]  # round to float, so the error is calculated with the stored scale
+    quantized = [max(-127, min(127, int(round(value / scales[channel(index)])))) for index, value in enumerate(values)]
+    error = max(abs(q * scales[channel(index)] - value) for index, (q, value) in enumerate(zip(quantized, values)))
+    return quantized, scales, error
+
+
+def dequantize_node(name, axis):
+    attribute = encode([(1, LENGTH_DELIMITED, b'axis'), (3, VARINT, axis), (20, VARINT, ATTRIBUTE_INT)])
+    fields = [(1, LENGTH_DELIMITED, (name + suffix).encode()) for suffix in ('_quantized', '_scale', '_zero_point')]
+    fields += [(2, LENGTH_DELIMITED, name.encode()), (3, LENGTH_DELIMITED, (name + '_DequantizeLinear').encode()), (4, LENGTH_DELIMITED, b'DequantizeLinear')]
+    fields += [(5, LENGTH_DELIMITED, attribute)]
+    return encode(fields)
+
+
+def quantize_model(input_file, output_file):
+    model = parse(open(input_file, 'rb').read())
+    graph = parse(get_fields(model, 7)[0])
+
+    # find weights to quantize from the nodes that use them
+    axes = {}
+    for node in get_fields(graph, 1):
+        node_fields = parse(node)
+        inputs = [value.decode() for value in get_fields(node_fields, 1)]
+        for index, axis in QUANTIZED_INPUTS.get(get_string(node_fields, 4), {}).items():
+            if index < len(inputs):
+                axes[inputs[index]] = axis
+
+    nodes, initializers = [], []
+    for number, wire_type, value in graph:
+        if number != 5:
+            continue
+        tensor = read_tensor(value)
+        if tensor is None or tensor[0] not in axes:
+            initializers.append((number, wire_type, value))
+            continue
+        name, dims, values = tensor
+        axis = axes[name] % len(dims)
+        quantized, scales, error = quantize(dims, values, axis)
+        print('%-60s %-14s axis %d, max error %.2e' % (name, dims, axis, error))
+        initializers.append((5, LENGTH_DELIMITED, write_tensor(name + '_quantized', dims, TENSOR_INT8, struct.pack('<%db' % len(quantized), *quantized))))
+        initializers.append((5, LENGTH_DELIMITED, write_tensor(name + '_scale', [len(scales)], TENSOR_FLOAT, struct.pack('<%df' % len(scales), *scales))))
+        initializers.append((5, LENGTH_DELIMITED, write_tensor(name + '_zero_point', [len(scales)], TENSOR_INT8, bytes(len(scales)))))
+        nodes.append((1, LENGTH_DELIMITED, dequantize_node(name, axis)))
+
+    # DequantizeLinear nodes are put first, so the nodes are still sorted topologically
+    graph_quantized = nodes + [field for field in graph if field[0] == 1] + initializers + [field for field in graph if field[0] not in (1, 5)]
+    model_quantized = [(7, LENGTH_DELIMITED, encode(graph_quantized)) if number == 7 else (number, wire_type, value) for number, wire_type, value in model]
+    open(output_file, 'wb').write(encode(model_quantized))
+    print('Quantized %d weights and wrote %s' % (len(nodes), output_file))
+
+
+if __name__ == '__main__':
+    if len(sys.argv) != 3:
+        print('usage: python quantize_model.py input.onnx output.onnx')
+        sys.exit(1)
+    quantize_model(sys.argv[1], sys.argv[2])
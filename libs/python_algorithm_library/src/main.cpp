@@ -178,6 +178,7 @@ inline auto process(Talgo &algo, std::tuple<ArgsIn...> &input, std::tuple<ArgsOu
         .def("setSetup", [](AlgorithmName &algo, const nlohmann::json &s) { algo.setSetup(s); })                                                                              \
         .def("getDebugJson", [](const AlgorithmName &algo) { return static_cast<nlohmann::json>(algo.getDebugJson()); })                                                      \
         .def("setDebugJson", [](AlgorithmName &algo, const nlohmann::json &s) { algo.setDebugJson(s); })                                                                      \
+        .def("getProfileTree", [](const AlgorithmName &algo) { return static_cast<nlohmann::json>(algo.getProfileTree()); })                                                  \
         .def("validInput",                                                                                                                                                    \
              [](const AlgorithmName &algo, py::args args) {                                                                                                                   \
                  auto input = make_tuple_from_python<AlgorithmName::Input>(std::move(args));                                                                                  \
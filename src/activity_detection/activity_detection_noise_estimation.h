@@ -1,7 +1,7 @@
 #pragma once
 #include "algorithm_library/activity_detection.h"
 #include "framework/framework.h"
-#include "utilities/fastonebigheader.h"
+#include "utilities/vector_math.h"
 
 class ActivityDetectionNoiseEstimation : public AlgorithmImplementation<ActivityDetectionConfiguration, ActivityDetectionNoiseEstimation>
 {
@@ -23,14 +23,7 @@ class ActivityDetectionNoiseEstimation : public AlgorithmImplementation<Activity
     {
         // activity detection
         activity = (powerNoisy / (powerNoise + 1e-20f) - 3.5f).cwiseMin(25.f);
-
-        // for-loop has been profiled to be faster in gcc than the commented line below:
-        // activity =activity.unaryExpr(std::ref(fasterExp));
-        float *ptr = activity.data();
-        for (auto i = 0; i < activity.size(); i++, ptr++)
-        {
-            *ptr = fasterexp(*ptr);
-        }
+        VectorMath::exp(activity, activity);
 
         activity /= (1.f + activity);
 
@@ -1,3 +1,14 @@
 #include "beamformer/beamformer_mvdr.h"
+#include "beamformer/beamformer_mvdr_recursive.h"
 
-DEFINE_ALGORITHM_CONSTRUCTOR(Beamformer, BeamformerMVDR, BeamformerConfiguration)
+using MVDRImpl = Implementation<BeamformerMVDR, BeamformerConfiguration>;
+using MVDRRecursiveImpl = Implementation<BeamformerMVDRRecursive, BeamformerConfiguration>;
+
+template <>
+void Algorithm<BeamformerConfiguration>::setImplementation(const Coefficients &c)
+{
+    if (c.beamformerType == c.RECURSIVE_INVERSE) { pimpl = std::make_unique<MVDRRecursiveImpl>(c); }
+    else { pimpl = std::make_unique<MVDRImpl>(c); }
+}
+
+Beamformer::Beamformer(const Coefficients &c) : Algorithm<BeamformerConfiguration>(c) {}
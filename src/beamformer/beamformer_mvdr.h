@@ -4,6 +4,12 @@
 
 // Minimum variance distortionless response beamformer.
 //
+// The lower triangles of the covariance matrices are stored packed column-wise in arrays of size nBands x nChannels*(nChannels+1)/2, so each
+// covariance element is contiguous across bands and the covariance update vectorizes across bands. The filters are calculated from the
+// generalized eigenvectors of (Rx, Rn). For 2 channels the eigenvectors are calculated in closed form, for 4 and 8 channels with fixed-size
+// matrices, and for other channel counts with dynamic-size matrices. The filter calculation doesn't allocate heap memory for up to maxChannels
+// channels.
+//
 // author: Kristian Timm Andersen
 class BeamformerMVDR : public AlgorithmImplementation<BeamformerConfiguration, BeamformerMVDR>
 {
@@ -15,22 +21,24 @@ class BeamformerMVDR : public AlgorithmImplementation<BeamformerConfiguration, B
 
         filter.resize(c.nBands, c.nChannels);
         filterNoise.resize(c.nBands, c.nChannels);
-        eigenVectors.resize(c.nChannels, c.nChannels);
-        Rx.resize(c.nBands);
-        for (auto &rx : Rx)
+        const int nPacked = c.nChannels * (c.nChannels + 1) / 2;
+        Rx.resize(c.nBands, nPacked);
+        Rn.resize(c.nBands, nPacked);
+        Rxn.resize(c.nBands);
+        if (c.nChannels <= maxChannels)
         {
-            rx.resize(c.nChannels, c.nChannels);
+            RxBand.resize(c.nChannels, c.nChannels);
+            RnBand.resize(c.nChannels, c.nChannels);
+            eigenSolver = Eigen::GeneralizedSelfAdjointEigenSolver<MatrixMaxSize>(c.nChannels);
         }
-        Rn.resize(c.nBands);
-        for (auto &rn : Rn)
+        else
         {
-            rn.resize(c.nChannels, c.nChannels);
+            RxBandLarge.resize(c.nChannels, c.nChannels);
+            RnBandLarge.resize(c.nChannels, c.nChannels);
+            eigenSolverLarge = Eigen::GeneralizedSelfAdjointEigenSolver<Eigen::MatrixXcf>(c.nChannels);
         }
-        Rxn.resize(c.nChannels, c.nChannels);
-        eigenSolver = Eigen::GeneralizedSelfAdjointEigenSolver<Eigen::MatrixXcf>(c.nChannels);
 
         resetVariables();
-        eigenSolver.compute(Rx[0], Rn[0]); // run once to make sure calculation works
     }
 
     enum SpeechUpdateDecisions { NOISE, SPEECH, INPUT, FREEZE_UPDATE };
@@ -64,73 +72,164 @@ class BeamformerMVDR : public AlgorithmImplementation<BeamformerConfiguration, B
 
     void covarianceUpdate(Input input)
     {
-        for (auto band = 0; band < C.nBands; band++)
+        // only calculate lower triangular covariance matrix, since that is all that is used by eigensolver
+        // Full matrix is: Rxn = input.xFreq.matrix().row(band).transpose() * input.xFreq.matrix().row(band).conjugate();
+        for (auto channel = 0, k = 0; channel < C.nChannels; channel++)
         {
-            // only calculate lower triangular covariance matrix, since that is all that is used by eigensolver
-            // Full matrix is: Rxn = input.xFreq.matrix().row(i).transpose() * input.xFreq.matrix().row(i).conjugate();
-            for (auto channel = 0; channel < C.nChannels; channel++)
+            for (auto row = channel; row < C.nChannels; row++, k++)
             {
-                Rxn.block(channel, channel, C.nChannels - channel, 1) =
-                    input.xFreq.block(band, channel, 1, C.nChannels - channel).transpose().matrix() * std::conj(input.xFreq(band, channel));
+                Rxn = input.xFreq.col(row) * input.xFreq.col(channel).conjugate();
+                Rx.col(k) += covarianceUpdateLambda * (Rxn - Rx.col(k));
+                if (!input.signalOfInterestFlag) { Rn.col(k) += covarianceUpdateLambda * (Rxn - Rn.col(k)); }
             }
-            Rx[band] += covarianceUpdateLambda * (Rxn - Rx[band]);
-            if (!input.signalOfInterestFlag) { Rn[band] += covarianceUpdateLambda * (Rxn - Rn[band]); }
         }
     }
 
     void calculateFilter()
     {
-        Rx[currentBand] += 1e-16f * Eigen::MatrixXcf::Identity(C.nChannels, C.nChannels);
-        Rn[currentBand] += 1e-17f * Eigen::MatrixXcf::Identity(C.nChannels, C.nChannels);
-        eigenSolver.compute(Rx[currentBand], Rn[currentBand]);
-        eigenVectors = eigenSolver.eigenvectors();
-        Eigen::MatrixXcf invEigen = eigenVectors.inverse();
+        for (auto channel = 0; channel < C.nChannels; channel++)
+        {
+            const int k = getPackedIndex(channel, channel);
+            Rx(currentBand, k) += 1e-16f;
+            Rn(currentBand, k) += 1e-17f;
+        }
+
+        switch (C.nChannels)
+        {
+        case 2: calculateFilterFixedSize<2>(); break;
+        case 4: calculateFilterFixedSize<4>(); break;
+        case 8: calculateFilterFixedSize<8>(); break;
+        default:
+            if (C.nChannels <= maxChannels) { calculateFilterDynamicSize(RxBand, RnBand, eigenSolver); }
+            else { calculateFilterDynamicSize(RxBandLarge, RnBandLarge, eigenSolverLarge); }
+            break;
+        }
+    }
+
+    template <typename Matrix>
+    void calculateFilterDynamicSize(Matrix &rx, Matrix &rn, Eigen::GeneralizedSelfAdjointEigenSolver<Matrix> &solver)
+    {
+        unpackCovariance(Rx, rx);
+        unpackCovariance(Rn, rn);
+        solver.compute(rx, rn);
+        setFilter(solver.eigenvectors().col(C.nChannels - 1), solver.eigenvectors().col(0), rn);
+    }
+
+    template <int M>
+    void calculateFilterFixedSize()
+    {
+        Eigen::Matrix<std::complex<float>, M, M> rx, rn;
+        unpackCovariance(Rx, rx);
+        unpackCovariance(Rn, rn);
+        Eigen::Matrix<std::complex<float>, M, 1> eigenvectorMax, eigenvectorMin;
+        calculateEigenvectorsMaxMin(rx, rn, eigenvectorMax, eigenvectorMin);
+        setFilter(eigenvectorMax, eigenvectorMin, rn);
+    }
+
+    // generalized eigenvectors of (rx, rn) with the largest and smallest eigenvalues, normalized such that v^H * rn * v = 1. Only the lower
+    // triangles of rx and rn are used.
+    template <int M>
+    static void calculateEigenvectorsMaxMin(const Eigen::Matrix<std::complex<float>, M, M> &rx, const Eigen::Matrix<std::complex<float>, M, M> &rn,
+                                            Eigen::Matrix<std::complex<float>, M, 1> &eigenvectorMax, Eigen::Matrix<std::complex<float>, M, 1> &eigenvectorMin)
+    {
+        Eigen::GeneralizedSelfAdjointEigenSolver<Eigen::Matrix<std::complex<float>, M, M>> solver(rx, rn);
+        eigenvectorMax = solver.eigenvectors().col(M - 1);
+        eigenvectorMin = solver.eigenvectors().col(0);
+    }
 
-        // calculate max/min_snr beamformer with mic 0 as reference
-        Eigen::VectorXcf filterMax = eigenVectors.col(C.nChannels - 1) * invEigen(C.nChannels - 1, 0);
-        Eigen::VectorXcf filterMin = eigenVectors.col(0) * invEigen(C.nChannels - 1, C.nChannels - 1);
+    // closed form solution for 2 channels: rn = L * L^H is Cholesky factorized, the standard eigenvectors u of L^-1 * rx * L^-H are calculated
+    // and transformed to the generalized eigenvectors v = L^-H * u.
+    static void calculateEigenvectorsMaxMin(const Eigen::Matrix2cf &rx, const Eigen::Matrix2cf &rn, Eigen::Vector2cf &eigenvectorMax, Eigen::Vector2cf &eigenvectorMin)
+    {
+        const float l00 = std::sqrt(std::max(rn(0, 0).real(), std::numeric_limits<float>::min()));
+        const std::complex<float> l10 = rn(1, 0) / l00;
+        const float l11 = std::sqrt(std::max(rn(1, 1).real() - std::norm(l10), std::numeric_limits<float>::min()));
+        Eigen::Matrix2cf lInv;
+        lInv << 1.f / l00, 0.f, -l10 / (l00 * l11), 1.f / l11;
+        const Eigen::Matrix2cf c = lInv * rx.selfadjointView<Eigen::Lower>() * lInv.adjoint();
 
-        // calculate noise power in max/min filter
-        const float noisePowMaxSNR = (filterMax.adjoint() * Rn[currentBand] * filterMax)(0).real();
-        const float noisePowMinSNR = (filterMin.adjoint() * Rn[currentBand] * filterMin)(0).real();
+        // eigenvector with the largest eigenvalue of the Hermitian matrix c. Of the two equivalent expressions the numerically stable one is chosen
+        const float halfDiff = 0.5f * (c(0, 0).real() - c(1, 1).real());
+        const float radius = std::sqrt(halfDiff * halfDiff + std::norm(c(1, 0)));
+        Eigen::Vector2cf u;
+        if (halfDiff >= 0.f) { u << halfDiff + radius, c(1, 0); }
+        else { u << std::conj(c(1, 0)), radius - halfDiff; }
+        const float uNorm = u.norm();
+        if (uNorm > 0.f) { u /= uNorm; }
+        else { u << 1.f, 0.f; } // c is a scaled identity matrix so any vector is an eigenvector
+
+        eigenvectorMax = lInv.adjoint() * u;
+        eigenvectorMin = lInv.adjoint() * Eigen::Vector2cf(-std::conj(u(1)), std::conj(u(0))); // orthogonal to u
+    }
+
+    // Calculate max/min SNR beamformer with mic 0 as reference from the normalized generalized eigenvectors. Since V^H * Rn * V = I, the
+    // inverse of the eigenvector matrix V is V^H * Rn, and the noise powers in the max/min filters are the squared magnitudes of the scale
+    // factors.
+    template <typename VectorMax, typename VectorMin, typename Matrix>
+    void setFilter(const VectorMax &eigenvectorMax, const VectorMin &eigenvectorMin, const Matrix &rn)
+    {
+        const std::complex<float> scaleMax = eigenvectorMax.dot(rn.col(0));                    // element (nChannels-1, 0) of inverse eigenvector matrix
+        const std::complex<float> scaleMin = eigenvectorMax.dot(rn.row(C.nChannels - 1).adjoint()); // element (nChannels-1, nChannels-1)
+        const float noisePowMaxSNR = std::norm(scaleMax);
+        const float noisePowMinSNR = std::norm(scaleMin);
 
         // put resulting conjugated beamformer for current band into Filter
-        filter.row(currentBand) = filterMax.adjoint();
+        filter.row(currentBand) = (eigenvectorMax * scaleMax).adjoint();
         // scale to power in max filter
-        filterNoise.row(currentBand) = filterMin.adjoint() * std::min(std::max(std::sqrt(noisePowMaxSNR / std::max(noisePowMinSNR, 1e-20f)), 1e-4f), 1e4f);
+        filterNoise.row(currentBand) =
+            (eigenvectorMin * scaleMin).adjoint() * std::min(std::max(std::sqrt(noisePowMaxSNR / std::max(noisePowMinSNR, 1e-20f)), 1e-4f), 1e4f);
     }
 
-    void resetVariables() final
+    template <typename Matrix>
+    void unpackCovariance(const Eigen::ArrayXXcf &R, Matrix &matrix) const
     {
-        currentBand = 0;
-        for (auto i = 0u; i < Rx.size(); i++)
+        for (auto channel = 0, k = 0; channel < C.nChannels; channel++)
         {
-            Rx[i].setZero();
-            Rx[i](0, 0) = 1e-5f;
-            Rn[i].setZero();
+            for (auto row = channel; row < C.nChannels; row++, k++)
+            {
+                matrix(row, channel) = R(currentBand, k);
+            }
         }
-        eigenVectors.setZero();
+    }
+
+    // index of lower triangular element (row >= column) in the packed covariance arrays
+    int getPackedIndex(int row, int column) const { return column * C.nChannels - column * (column - 1) / 2 + row - column; }
+
+    bool isCoefficientsValid() const final
+    {
+        bool flag = C.beamformerType == C.EIGEN_DECOMPOSITION; // RECURSIVE_INVERSE is implemented by BeamformerMVDRRecursive
+        flag &= C.nChannels >= 1;
+        flag &= C.nBands >= 1;
+        flag &= C.filterbankRate > 0.f;
+        return flag;
+    }
+
+    void resetVariables() final
+    {
+        currentBand = 0;
+        Rx.setZero();
+        Rx.col(0) = 1e-5f;
+        Rn.setZero();
         filter.setZero();
         filter.col(0) = 1;
         filterNoise.setZero();
 
         Rxn.setZero();
+        RxBand.setZero();
+        RnBand.setZero();
+        RxBandLarge.setZero();
+        RnBandLarge.setZero();
     }
 
     size_t getDynamicSizeVariables() const final
     {
         size_t size = filter.getDynamicMemorySize();
         size += filterNoise.getDynamicMemorySize();
-        for (auto &rx : Rx)
-        {
-            size += rx.getDynamicMemorySize();
-        }
-        for (auto &rn : Rn)
-        {
-            size += rn.getDynamicMemorySize();
-        }
-        size += eigenVectors.getDynamicMemorySize();
+        size += Rx.getDynamicMemorySize();
+        size += Rn.getDynamicMemorySize();
         size += Rxn.getDynamicMemorySize();
+        size += RxBandLarge.getDynamicMemorySize();
+        size += RnBandLarge.getDynamicMemorySize();
         return size;
     }
 
@@ -142,9 +241,17 @@ class BeamformerMVDR : public AlgorithmImplementation<BeamformerConfiguration, B
     int currentBand;
     Eigen::ArrayXXcf filter;
     Eigen::ArrayXXcf filterNoise;
-    std::vector<Eigen::MatrixXcf> Rx, Rn;
-    Eigen::GeneralizedSelfAdjointEigenSolver<Eigen::MatrixXcf> eigenSolver;
-    Eigen::MatrixXcf eigenVectors, Rxn;
+    Eigen::ArrayXXcf Rx, Rn; // packed lower triangular covariance matrices with size nBands x nChannels*(nChannels+1)/2
+    Eigen::ArrayXcf Rxn;
+
+    // unpacked covariance matrices of current band used for channel counts without a fixed-size solver. The matrices have a maximum size, so
+    // they and all temporaries in the solver are allocated without using the heap. Larger channel counts use heap allocated matrices.
+    static constexpr int maxChannels = 32;
+    using MatrixMaxSize = Eigen::Matrix<std::complex<float>, Eigen::Dynamic, Eigen::Dynamic, 0, maxChannels, maxChannels>;
+    MatrixMaxSize RxBand, RnBand;
+    Eigen::GeneralizedSelfAdjointEigenSolver<MatrixMaxSize> eigenSolver;
+    Eigen::MatrixXcf RxBandLarge, RnBandLarge;
+    Eigen::GeneralizedSelfAdjointEigenSolver<Eigen::MatrixXcf> eigenSolverLarge;
 
     friend BaseAlgorithm;
-};
\ No newline at end of file
+};
@@ -0,0 +1,232 @@
+#pragma once
+#include "algorithm_library/beamformer.h"
+#include "framework/framework.h"
+
+// Minimum variance distortionless response beamformer, where the inverse noise covariance matrix is tracked recursively with rank-1
+// Sherman-Morrison updates, and the filters in all bands are updated every frame.
+//
+// The steering vector is estimated as d = Rn * v / (Rn * v)_0, where v is the generalized eigenvector of (Rx, Rn) with the largest
+// eigenvalue. v is tracked with one power iteration v = Rn^-1 * Rx * v per frame. All operations cost O(nChannels^2) per band and are
+// vectorized across bands, since all matrices are stored with their packed lower triangles contiguous across bands.
+//
+// author: Kristian Timm Andersen
+class BeamformerMVDRRecursive : public AlgorithmImplementation<BeamformerConfiguration, BeamformerMVDRRecursive>
+{
+  public:
+    BeamformerMVDRRecursive(const Coefficients &c = {.beamformerType = Coefficients::RECURSIVE_INVERSE}) : BaseAlgorithm{c}
+    {
+        covarianceUpdateLambda = 1.f - expf(-1.f / (c.filterbankRate * covarianceUpdateTConstant));
+        diagonalLoading = noiseFloor * c.nChannels * covarianceUpdateLambda;
+
+        filter.resize(c.nBands, c.nChannels);
+        filterNoise.resize(c.nBands, c.nChannels);
+        const int nPacked = c.nChannels * (c.nChannels + 1) / 2;
+        Rx.resize(c.nBands, nPacked);
+        Rn.resize(c.nBands, nPacked);
+        RnInv.resize(c.nBands, nPacked);
+        Rxn.resize(c.nBands);
+        eigenvector.resize(c.nBands, c.nChannels);
+        temp.resize(c.nBands, c.nChannels);
+        denominator.resize(c.nBands);
+        noisePow.resize(c.nBands);
+        factor.resize(c.nBands);
+        gain.resize(c.nBands);
+
+        resetVariables();
+    }
+
+    enum SpeechUpdateDecisions { NOISE, SPEECH, INPUT, FREEZE_UPDATE };
+    void setSpeechDecision(SpeechUpdateDecisions sd) { speechDecision = sd; }
+    SpeechUpdateDecisions getSpeechDecision() const { return speechDecision; }
+
+  private:
+    void processAlgorithm(Input input, Output output)
+    {
+        bool activityFlag = input.signalOfInterestFlag;
+
+        switch (speechDecision)
+        {
+        case SPEECH: activityFlag = true; break;
+        case NOISE: activityFlag = false; break;
+        default: break;
+        }
+
+        if (speechDecision != FREEZE_UPDATE) { covarianceUpdate({input.xFreq, activityFlag}); }
+
+        calculateFilter();
+
+        output.yFreq = (input.xFreq * filter).rowwise().sum();
+        output.noiseFreq = (input.xFreq * filterNoise).rowwise().sum();
+    }
+
+    void covarianceUpdate(Input input)
+    {
+        if (!input.signalOfInterestFlag) { inverseNoiseCovarianceUpdate(input.xFreq); }
+
+        const std::complex<float> lambda = covarianceUpdateLambda; // complex scalar, since mixed real/complex expressions are not vectorized
+        for (auto channel = 0, k = 0; channel < C.nChannels; channel++)
+        {
+            for (auto row = channel; row < C.nChannels; row++, k++)
+            {
+                Rxn = input.xFreq.col(row) * input.xFreq.col(channel).conjugate();
+                Rx.col(k) += lambda * (Rxn - Rx.col(k));
+                if (!input.signalOfInterestFlag) { Rn.col(k) += lambda * (Rxn - Rn.col(k)); }
+            }
+        }
+
+        if (!input.signalOfInterestFlag) { diagonalLoadingUpdate(); }
+    }
+
+    // Sherman-Morrison update of RnInv for Rn = (1 - lambda) * Rn + lambda * x * x^H:
+    // RnInv = (RnInv - lambda * RnInv * x * x^H * RnInv / (1 - lambda + lambda * x^H * RnInv * x)) / (1 - lambda)
+    void inverseNoiseCovarianceUpdate(I::Complex2D xFreq)
+    {
+        multiplyHermitian(RnInv, xFreq, temp);
+        denominator = covarianceUpdateLambda / (1.f - covarianceUpdateLambda + covarianceUpdateLambda * (xFreq.conjugate() * temp).rowwise().sum().real());
+        rankOneUpdate(1.f / (1.f - covarianceUpdateLambda));
+    }
+
+    // Load the diagonal of one channel per noise frame with the rank-1 update Rn = Rn + diagonalLoading * e_c * e_c^H. On average the
+    // diagonal is loaded with noiseFloor, which bounds the condition number of Rn and prevents RnInv from growing without limit.
+    void diagonalLoadingUpdate()
+    {
+        const int c = loadingChannel;
+        for (auto row = 0; row < C.nChannels; row++)
+        {
+            if (row >= c) { temp.col(row) = RnInv.col(getPackedIndex(row, c)); }
+            else { temp.col(row) = RnInv.col(getPackedIndex(c, row)).conjugate(); }
+        }
+        denominator = diagonalLoading / (1.f + diagonalLoading * RnInv.col(getPackedIndex(c, c)).real());
+        rankOneUpdate(1.f);
+        Rn.col(getPackedIndex(c, c)) += diagonalLoading;
+        loadingChannel = (loadingChannel + 1) % C.nChannels;
+    }
+
+    // RnInv = scale * (RnInv - denominator * g * g^H), where g is stored in temp
+    void rankOneUpdate(std::complex<float> scale)
+    {
+        factor = denominator.cast<std::complex<float>>();
+        for (auto channel = 0, k = 0; channel < C.nChannels; channel++)
+        {
+            gain = factor * temp.col(channel).conjugate();
+            for (auto row = channel; row < C.nChannels; row++, k++)
+            {
+                RnInv.col(k) = scale * (RnInv.col(k) - gain * temp.col(row));
+            }
+            // the diagonal is kept exactly real, since a non-Hermitian error in RnInv grows by 1 / (1 - lambda) every update
+            RnInv.col(getPackedIndex(channel, channel)).imag().setZero();
+        }
+    }
+
+    void calculateFilter()
+    {
+        // one power iteration v = RnInv * (Rx + noiseFloor * I) * v. The regularization prevents v from vanishing if Rx is zero
+        multiplyHermitian(Rx, eigenvector, temp);
+        temp += std::complex<float>(noiseFloor) * eigenvector;
+        multiplyHermitian(RnInv, temp, eigenvector);
+        denominator = 1.f / eigenvector.abs2().rowwise().sum().sqrt().max(1e-30f);
+        factor = denominator.cast<std::complex<float>>();
+        eigenvector.colwise() *= factor;
+
+        // MVDR filter w = RnInv * d / (d^H * RnInv * d) with d = u / u_0 and u = Rn * v simplifies to w = v * conj(u_0) / (v^H * u)
+        multiplyHermitian(Rn, eigenvector, temp);
+        denominator = 1.f / (eigenvector.conjugate() * temp).rowwise().sum().real().max(1e-30f);
+        gain = temp.col(0) * denominator.cast<std::complex<float>>();
+        filter = eigenvector.conjugate().colwise() * gain; // conjugated filter
+
+        // noise filter b = e_0 - w cancels the steering vector, and it is scaled to the residual noise power in w, where
+        // w^H * Rn * w = |u_0|^2 / (v^H * u) and b^H * Rn * b = Rn_00 - w^H * Rn * w
+        noisePow = temp.col(0).abs2() * denominator;
+        denominator = (noisePow / (Rn.col(0).real() - noisePow).max(1e-20f)).sqrt().max(1e-4f).min(1e4f);
+        factor = denominator.cast<std::complex<float>>();
+        filterNoise = -(filter.colwise() * factor);
+        filterNoise.col(0) += factor;
+    }
+
+    // y = R * x for all bands, where R is Hermitian with the lower triangle stored packed
+    void multiplyHermitian(I::Complex2D R, I::Complex2D x, O::Complex2D y) const
+    {
+        y.setZero();
+        for (auto channel = 0, k = 0; channel < C.nChannels; channel++)
+        {
+            y.col(channel) += R.col(k) * x.col(channel);
+            k++;
+            for (auto row = channel + 1; row < C.nChannels; row++, k++)
+            {
+                y.col(row) += R.col(k) * x.col(channel);
+                y.col(channel) += R.col(k).conjugate() * x.col(row);
+            }
+        }
+    }
+
+    // index of lower triangular element (row >= column) in the packed covariance arrays
+    int getPackedIndex(int row, int column) const { return column * C.nChannels - column * (column - 1) / 2 + row - column; }
+
+    bool isCoefficientsValid() const final
+    {
+        bool flag = C.beamformerType == C.RECURSIVE_INVERSE; // EIGEN_DECOMPOSITION is implemented by BeamformerMVDR
+        flag &= C.nChannels >= 1;
+        flag &= C.nBands >= 1;
+        flag &= C.filterbankRate > 0.f;
+        return flag;
+    }
+
+    void resetVariables() final
+    {
+        Rx.setZero();
+        Rx.col(0) = 1e-5f;
+        Rn.setZero();
+        RnInv.setZero();
+        for (auto channel = 0; channel < C.nChannels; channel++)
+        {
+            Rn.col(getPackedIndex(channel, channel)) = noiseFloor;
+            RnInv.col(getPackedIndex(channel, channel)) = 1.f / noiseFloor;
+        }
+        eigenvector.setZero();
+        eigenvector.col(0) = 1;
+        filter.setZero();
+        filter.col(0) = 1;
+        filterNoise.setZero();
+        loadingChannel = 0;
+
+        Rxn.setZero();
+        temp.setZero();
+        denominator.setZero();
+        noisePow.setZero();
+        factor.setZero();
+        gain.setZero();
+    }
+
+    size_t getDynamicSizeVariables() const final
+    {
+        size_t size = filter.getDynamicMemorySize();
+        size += filterNoise.getDynamicMemorySize();
+        size += Rx.getDynamicMemorySize();
+        size += Rn.getDynamicMemorySize();
+        size += RnInv.getDynamicMemorySize();
+        size += Rxn.getDynamicMemorySize();
+        size += eigenvector.getDynamicMemorySize();
+        size += temp.getDynamicMemorySize();
+        size += denominator.getDynamicMemorySize();
+        size += noisePow.getDynamicMemorySize();
+        size += factor.getDynamicMemorySize();
+        size += gain.getDynamicMemorySize();
+        return size;
+    }
+
+    SpeechUpdateDecisions speechDecision = INPUT;
+    static constexpr float covarianceUpdateTConstant = 5.f; // covariance update smoothing time constant in seconds
+    static constexpr float noiseFloor = 1e-10f;              // average diagonal loading of noise covariance matrix
+    float covarianceUpdateLambda;
+    float diagonalLoading;
+    int loadingChannel;
+    Eigen::ArrayXXcf filter;
+    Eigen::ArrayXXcf filterNoise;
+    Eigen::ArrayXXcf Rx, Rn, RnInv; // packed lower triangular matrices with size nBands x nChannels*(nChannels+1)/2
+    Eigen::ArrayXcf Rxn;
+    Eigen::ArrayXXcf eigenvector, temp;
+    Eigen::ArrayXf denominator, noisePow;
+    Eigen::ArrayXcf factor, gain;
+
+    friend BaseAlgorithm;
+};
@@ -33,24 +33,22 @@ class CircularBuffer : public AlgorithmImplementation<DelayConfiguration, Circul
         }
     }
 
-    inline Eigen::ArrayXf get(const int indexGet) const
+    // the returned expressions refer to the buffer, so they must be evaluated before the next call to push or process
+    inline auto get(const int indexGet) const
     {
         auto newIndex = index - indexGet - 1;
         if (newIndex < 0) { newIndex += C.delayLength; }
-        return buffer.row(newIndex);
+        return buffer.row(newIndex).transpose();
     }
 
-    inline Eigen::ArrayXf get(const float indexGet) const
+    inline auto get(const float indexGet) const
     {
         auto newIndex = index - indexGet - 1;
         if (newIndex < 0.f) { newIndex += C.delayLength; }
-        auto intIndex = static_cast<int>(newIndex);
+        const int intIndex = static_cast<int>(newIndex);
         const auto remainder = newIndex - intIndex;
-        Eigen::ArrayXf value = buffer.row(intIndex).transpose();
-        intIndex++;
-        if (intIndex == C.delayLength) { intIndex = 0; }
-        value += remainder * (buffer.row(intIndex).transpose() - value);
-        return value;
+        const int intIndexNext = intIndex + 1 == C.delayLength ? 0 : intIndex + 1;
+        return (1.f - remainder) * buffer.row(intIndex).transpose() + remainder * buffer.row(intIndexNext).transpose();
     }
 
   private:
@@ -3,16 +3,23 @@
 #include "fft/fft_real.h"
 #include "framework/framework.h"
 #include "min_phase_spectrum/min_phase_spectrum_cepstrum.h"
+#include <complex>
+#include <limits>
 #include <unsupported/Eigen/Polynomials>
 
 // Design minimum phase IIR filter from a magnitude spectrum. The IIR filter is factorized in a cascade of 2nd order sections.
 //
+// The roots of the transfer functions are found as the eigenvalues of the balanced companion matrix followed by a cleanup of the imaginary part of
+// real roots, like Eigen::PolynomialSolver does, but the companion matrix and the eigen solver are allocated in the constructor, so process doesn't
+// allocate heap memory.
+//
 // author: Kristian Timm Andersen
+
 class DesignIIRMinPhaseTF2SOS : public AlgorithmImplementation<DesignIIRMinPhaseConfiguration, DesignIIRMinPhaseTF2SOS>
 {
   public:
     DesignIIRMinPhaseTF2SOS(const DesignIIRMinPhaseConfiguration::Coefficients &c = Coefficients())
-        : BaseAlgorithm(c), minPhaseCalculator({c.nBands}), fft({2 * (c.nBands - 1)})
+        : BaseAlgorithm(c), minPhaseCalculator({c.nBands}), fft({2 * (c.nBands - 1)}), llt(2 * c.nOrder + 1), eigenSolver(c.nOrder)
     {
         fftSize = 2 * (c.nBands - 1);
         R.resize(2 * c.nOrder + 1, 2 * c.nOrder + 1);
@@ -25,9 +32,10 @@ class DesignIIRMinPhaseTF2SOS : public AlgorithmImplementation<DesignIIRMinPhase
         th.resize(2 * C.nOrder + 1);
         A.resize(C.nOrder + 1);
         B.resize(C.nOrder + 1);
-        rootsStable.resize(C.nOrder + 1);
-        roots.resize(C.nOrder + 1);
-        rootsPow.resize(C.nOrder + 1);
+        rootsStable.resize(C.nOrder);
+        roots.resize(C.nOrder);
+        rootsPow.resize(C.nOrder);
+        companionMatrix.resize(C.nOrder, C.nOrder);
         if (c.weightType == c.MELSCALE)
         {
             weight(0) = 1.6f;
@@ -49,16 +57,21 @@ class DesignIIRMinPhaseTF2SOS : public AlgorithmImplementation<DesignIIRMinPhase
         const auto N = tf.size() - 1;
         const auto N1 = N - 1;
 
-        //// This code is equivalent to the PolynomialSolver (with different ordering of roots), but is slightly slower when profiling. If this is used then
-        /// Eigen::EigenSolver<Eigen::MatrixXf> needs to be a member in class
-        // Eigen::MatrixXf companionMatrix = Eigen::MatrixXf::Zero(N, N);
-        // companionMatrix.diagonal(-1) = Eigen::VectorXf::Ones(N - 1);
-        // companionMatrix.row(0) = -tf.tail(N).transpose() / tf(0);
-        // D.EigenSolver.compute(companionMatrix);
-        // Eigen::VectorXcf poles = D.EigenSolver.eigenvalues();
+        computeCompanionMatrix(tf);
+        eigenSolver.compute(companionMatrix, false);
+        roots = eigenSolver.eigenvalues();
 
-        polynomialsolver.compute(tf.reverse().matrix());
-        roots = polynomialsolver.roots();
+        // remove numerical noise in the imaginary part of real roots. If the imaginary part is much smaller than the real part, and the polynomial is
+        // closer to zero at the real part, then only the real part is kept
+        const float precision = std::pow(4.f, static_cast<float>(N + 2)) * std::numeric_limits<float>::epsilon();
+        for (auto i = 0; i < N; i++)
+        {
+            if (std::abs(roots(i).imag()) <= std::abs(roots(i).real()) * precision)
+            {
+                const std::complex<float> rootReal(roots(i).real(), 0.f);
+                if (std::abs(Eigen::poly_eval(tf.reverse(), rootReal)) <= std::abs(Eigen::poly_eval(tf.reverse(), roots(i)))) { roots(i) = rootReal; }
+            }
+        }
         rootsPow = roots.array().abs2();
 
         auto start = 0;
@@ -97,6 +110,77 @@ class DesignIIRMinPhaseTF2SOS : public AlgorithmImplementation<DesignIIRMinPhase
     }
 
   private:
+    // write the companion matrix of the transfer function to companionMatrix and balance it with the algorithm from B. N. Parlett and C. Reinsch (1969),
+    // "Balancing a matrix for calculation of eigenvalues and eigenvectors", adapted to companion matrices. The matrix has ones on the subdiagonal and the
+    // negative normalized coefficients in the last column, and only these elements are scaled. The result is identical to the companion matrix in
+    // Eigen::PolynomialSolver.
+    void computeCompanionMatrix(I::Real tf)
+    {
+        const auto N = static_cast<int>(tf.size()) - 1;
+        companionMatrix.setZero();
+        companionMatrix.diagonal(-1).setOnes();
+        companionMatrix.col(N - 1) = -tf.tail(N).reverse().matrix() / tf(0);
+        if (N < 2) { return; }
+
+        auto diagonal = companionMatrix.diagonal(-1);
+        auto column = companionMatrix.col(N - 1);
+        float colScale, rowScale;
+        bool converged = false;
+        while (!converged)
+        {
+            converged = true;
+            if (!isBalanced(std::abs(diagonal(0)), std::abs(column(0)), colScale, rowScale))
+            {
+                diagonal(0) *= colScale;
+                column(0) *= rowScale;
+                converged = false;
+            }
+            for (auto i = 1; i < N - 1; i++)
+            {
+                if (!isBalanced(std::abs(diagonal(i)), std::abs(diagonal(i - 1)) + std::abs(column(i)), colScale, rowScale))
+                {
+                    diagonal(i) *= colScale;
+                    diagonal(i - 1) *= rowScale;
+                    column(i) *= rowScale;
+                    converged = false;
+                }
+            }
+            if (!isBalanced(column.head(N - 1).cwiseAbs().sum(), std::abs(diagonal(N - 2)), colScale, rowScale))
+            {
+                column.head(N - 1) *= colScale;
+                diagonal(N - 2) *= rowScale;
+                converged = false;
+            }
+        }
+    }
+
+    // return true if a column and row with the norms colNorm and rowNorm are balanced. Otherwise return false and the power of 2 scalings of the column
+    // and row that balance them
+    static bool isBalanced(float colNorm, float rowNorm, float &colScale, float &rowScale)
+    {
+        if (colNorm == 0.f || rowNorm == 0.f || !Eigen::numext::isfinite(colNorm) || !Eigen::numext::isfinite(rowNorm)) { return true; }
+
+        colScale = 1.f;
+        float scout = colNorm;
+        while (scout < rowNorm / 2.f)
+        {
+            colScale *= 2.f;
+            scout *= 4.f;
+        }
+        scout = colNorm * (colScale / 2.f) * colScale; // avoid overflow
+        while (scout >= rowNorm)
+        {
+            colScale /= 2.f;
+            scout /= 4.f;
+        }
+        if ((rowNorm + 2.f * scout) < 0.95f * (colNorm + rowNorm) * colScale)
+        {
+            rowScale = 1.f / colScale;
+            return false;
+        }
+        return true;
+    }
+
     void processAlgorithm(Input magnitudeSpectrum, Output output)
     {
         assert(magnitudeSpectrum.rows() == C.nBands);
@@ -129,7 +213,8 @@ class DesignIIRMinPhaseTF2SOS : public AlgorithmImplementation<DesignIIRMinPhase
         }
         Vd.head(C.nOrder) = -xTime.segment(1, C.nOrder);
 
-        th = R.llt().solve(Vd);
+        llt.compute(R);
+        th = llt.solve(Vd);
 
         A(0) = 1.f;
         A.tail(C.nOrder) = th.head(C.nOrder);
@@ -161,6 +246,7 @@ class DesignIIRMinPhaseTF2SOS : public AlgorithmImplementation<DesignIIRMinPhase
         size += rootsStable.getDynamicMemorySize();
         size += roots.getDynamicMemorySize();
         size += rootsPow.getDynamicMemorySize();
+        size += companionMatrix.getDynamicMemorySize();
         return size;
     }
 
@@ -168,7 +254,9 @@ class DesignIIRMinPhaseTF2SOS : public AlgorithmImplementation<DesignIIRMinPhase
     Eigen::ArrayXcf xFreq;
     Eigen::ArrayXf weight;
     Eigen::MatrixXf R;
-    Eigen::PolynomialSolver<float, Eigen::Dynamic> polynomialsolver;
+    Eigen::LLT<Eigen::MatrixXf> llt;
+    Eigen::MatrixXf companionMatrix;
+    Eigen::EigenSolver<Eigen::MatrixXf> eigenSolver;
     Eigen::ArrayXcf xPow;
     Eigen::ArrayXf xTime;
     Eigen::VectorXf Vd;
@@ -1,4 +1,6 @@
 #include "fft/fft_real.h"
+#include <map>
+#include <mutex>
 
 DEFINE_ALGORITHM_CONSTRUCTOR(FFT, FFTReal, FFTConfiguration)
 
@@ -13,7 +15,7 @@ constexpr std::array<int, 72> validFFTSizes = {32,    64,    96,    128,   160,
                                                10368, 11520, 12000, 12800, 12960, 13824, 14400, 15360, 15552, 16000, 17280, 18432, 19200, 20000, 20736, 21600, 23040, 23328};
 }
 
-// return valid fftSize that is equal or greater than fftSize
+// return fftSize that is equal or greater than fftSize and supported natively by pffft
 int FFTConfiguration::getValidFFTSize(const int fftSize)
 {
     if (fftSize > validFFTSizes.back())
@@ -23,22 +25,35 @@ int FFTConfiguration::getValidFFTSize(const int fftSize)
     return *std::upper_bound(validFFTSizes.begin(), validFFTSizes.end(), fftSize, [&](const int &a, const int &b) { return a <= b; });
 }
 
-bool FFTConfiguration::isFFTSizeValid(const int fftSize)
-{
-    if (fftSize % 32 != 0 || fftSize < 32) { return false; } // first check size is integer factor of 32
-    PFFFT_Setup *setup = pffft_new_setup(fftSize, PFFFT_REAL);
-    if (!setup) { return false; }
-    pffft_destroy_setup(setup);
-    return true;
-}
+// any size is supported, but sizes returned by getValidFFTSize are calculated natively by pffft and sizes not supported by pffft use Bluestein's algorithm
+bool FFTConfiguration::isFFTSizeValid(const int fftSize) { return fftSize > 1; }
 
 void FFTReal::pffftSmartDestroy(PFFFT_Setup *s)
 {
     if (s != nullptr) { pffft_destroy_setup(s); }
 } // only call delete function if shared pointer is not nullptr
 
-PFFFT_Setup *FFTReal::pffftSmartCreate(int fftSize)
+PFFFT_Setup *FFTReal::pffftSmartCreate(int fftSize, pffft_transform_t transform)
 {
-    if (fftSize % 32 == 0 && fftSize >= 32) { return pffft_new_setup(fftSize, PFFFT_REAL); }
+    const int minSize = transform == PFFFT_REAL ? 32 : 16;
+    if (fftSize % minSize == 0 && fftSize >= minSize) { return pffft_new_setup(fftSize, transform); }
     return nullptr;
+}
+
+// Return setup from process-wide cache or create a new one if no instance is currently using a setup with the same size and transform type.
+// The cache only holds weak pointers, so a setup is destroyed when the last FFTReal using it is destroyed.
+std::shared_ptr<PFFFT_Setup> FFTReal::getSharedSetup(int fftSize, pffft_transform_t transform)
+{
+    static std::mutex cacheMutex;
+    static std::map<std::pair<int, pffft_transform_t>, std::weak_ptr<PFFFT_Setup>> cache;
+
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    auto &cachedSetup = cache[{fftSize, transform}];
+    auto setup = cachedSetup.lock();
+    if (!setup)
+    {
+        setup = std::shared_ptr<PFFFT_Setup>(pffftSmartCreate(fftSize, transform), pffftSmartDestroy);
+        if (setup) { cachedSetup = setup; }
+    }
+    return setup;
 }
\ No newline at end of file
@@ -0,0 +1,119 @@
+#pragma once
+#include "framework/framework.h"
+#include "utilities/pffft.h"
+
+// Complex DFT of arbitrary length using Bluestein's algorithm (chirp z-transform).
+//
+// The DFT is rewritten as a circular convolution with a chirp, which is calculated with complex pffft transforms of the smallest size supported by pffft that is
+// equal or greater than 2*length-1. All buffers are allocated in the constructor, so forward() and inverse() don't allocate memory.
+// Both transforms are unnormalized and can output the first nOutputs bins only.
+//
+// author: Kristian Timm Andersen
+
+class FFTBluestein
+{
+  public:
+    FFTBluestein() = default;
+
+    // setupConvolution must be a complex pffft setup of size getConvolutionSize(length)
+    FFTBluestein(int length, std::shared_ptr<PFFFT_Setup> setupConvolution) : length(length), convolutionSize(getConvolutionSize(length)), setup(setupConvolution)
+    {
+        chirp.resize(length);
+        for (auto n = 0; n < length; n++)
+        {
+            // n^2 is wrapped to [0; 2*length[ before converting to floating point to keep precision for large n
+            const double phase = -3.141592653589793 * static_cast<double>((static_cast<long long>(n) * n) % (2 * length)) / length;
+            chirp(n) = std::complex<float>(static_cast<float>(std::cos(phase)), static_cast<float>(std::sin(phase)));
+        }
+
+        timeBuffer = Eigen::ArrayXcf::Zero(convolutionSize);
+        freqBuffer.resize(convolutionSize);
+        convolutionBuffer.resize(convolutionSize);
+        work.resize(convolutionSize);
+
+        // chirp filter is stored in the internal pffft format since it is only used in pffft_zconvolve_accumulate
+        timeBuffer.head(length) = chirp.conjugate();
+        timeBuffer.tail(length - 1) = chirp.tail(length - 1).conjugate().reverse();
+        chirpFilter.resize(convolutionSize);
+        pffft_transform(setup.get(), reinterpret_cast<float *>(timeBuffer.data()), reinterpret_cast<float *>(chirpFilter.data()), reinterpret_cast<float *>(work.data()),
+                        PFFFT_FORWARD);
+        timeBuffer.setZero();
+    }
+
+    // y(k) = sum_n x(n) exp(-2i*pi*n*k/length), k = 0,...,nOutputs-1
+    void forward(const std::complex<float> *x, std::complex<float> *y, int nOutputs)
+    {
+        timeBuffer.head(length) = Eigen::Map<const Eigen::ArrayXcf>(x, length) * chirp;
+        convolve();
+        Eigen::Map<Eigen::ArrayXcf>(y, nOutputs) = freqBuffer.head(nOutputs) * chirp.head(nOutputs);
+    }
+
+    // y(k) = sum_n x(n) exp(2i*pi*n*k/length), k = 0,...,nOutputs-1
+    void inverse(const std::complex<float> *x, std::complex<float> *y, int nOutputs)
+    {
+        timeBuffer.head(length) = Eigen::Map<const Eigen::ArrayXcf>(x, length).conjugate() * chirp;
+        convolve();
+        Eigen::Map<Eigen::ArrayXcf>(y, nOutputs) = (freqBuffer.head(nOutputs) * chirp.head(nOutputs)).conjugate();
+    }
+
+    // return smallest complex pffft size that is equal or greater than 2*length-1
+    static int getConvolutionSize(int length)
+    {
+        int size = (2 * length - 1 + 15) / 16 * 16; // complex pffft sizes are multiples of 16
+        while (!isFactorizable(size))
+        {
+            size += 16;
+        }
+        return size;
+    }
+
+    int getLength() const { return length; }
+
+    size_t getDynamicMemorySize() const
+    {
+        size_t size = chirp.getDynamicMemorySize();
+        size += chirpFilter.getDynamicMemorySize();
+        size += timeBuffer.getDynamicMemorySize();
+        size += freqBuffer.getDynamicMemorySize();
+        size += convolutionBuffer.getDynamicMemorySize();
+        size += work.getDynamicMemorySize();
+        return size;
+    }
+
+    size_t getSharedDynamicMemorySize() const
+    {
+        if (setup) { return pffft_get_setup_size(setup.get()) / setup.use_count(); }
+        return 0;
+    }
+
+  private:
+    // circular convolution of timeBuffer with chirp filter. Result is written to freqBuffer
+    void convolve()
+    {
+        pffft_transform(setup.get(), reinterpret_cast<float *>(timeBuffer.data()), reinterpret_cast<float *>(freqBuffer.data()), reinterpret_cast<float *>(work.data()),
+                        PFFFT_FORWARD);
+        convolutionBuffer.setZero();
+        pffft_zconvolve_accumulate(setup.get(), reinterpret_cast<float *>(freqBuffer.data()), reinterpret_cast<float *>(chirpFilter.data()),
+                                   reinterpret_cast<float *>(convolutionBuffer.data()), 1.f / convolutionSize);
+        pffft_transform(setup.get(), reinterpret_cast<float *>(convolutionBuffer.data()), reinterpret_cast<float *>(freqBuffer.data()),
+                        reinterpret_cast<float *>(work.data()), PFFFT_BACKWARD);
+    }
+
+    // return true if size only has prime factors 2, 3 and 5
+    static bool isFactorizable(int size)
+    {
+        for (auto factor : {2, 3, 5})
+        {
+            while (size % factor == 0)
+            {
+                size /= factor;
+            }
+        }
+        return size == 1;
+    }
+
+    int length = 0;
+    int convolutionSize = 0;
+    std::shared_ptr<PFFFT_Setup> setup;
+    Eigen::ArrayXcf chirp, chirpFilter, timeBuffer, freqBuffer, convolutionBuffer, work;
+};
@@ -1,31 +1,60 @@
 #pragma once
 #include "algorithm_library/fft.h"
+#include "fft/fft_bluestein.h"
 #include "framework/framework.h"
 #include "utilities/pffft.h"
 
 // Wrapper for real pffft.
 //
 // This class has a public inverse FFT function.
-// Supported FFT sizes are multiples of 32 and FFT class has a public isFFTSizeValid() method.
+// Any FFT size larger than 1 is supported. Sizes that are multiples of 32 with prime factors 2, 3 and 5 are calculated directly with pffft (see
+// FFTConfiguration::getValidFFTSize()). Other sizes fall back to Bluestein's algorithm built on complex pffft transforms, which is allocation-free after construction
+// but a few times slower than a native size. Even sizes are calculated as a complex transform of half the size.
+//
+// The forward transform writes directly into the output for every channel whose column is 16 byte aligned and only goes through a scratch buffer for the remaining
+// channels. With nBands = fftSize/2+1 rows only every second channel is aligned, so for many channels allocate the output with
+// FFTConfiguration::convertFFTSizeToNBandsPadded(fftSize) rows and pass the top nBands rows to process().
 //
 // NOTE: This class will throw an exception if FFT size is not supported.
 //
+// FFT setups (twiddle factors) are read-only after creation and are shared between all FFTReal instances with the same FFT size through a thread-safe, process-wide
+// cache. A setup is destroyed when the last instance using it is destroyed. getDynamicSize() reports memory owned by the instance and getSharedDynamicSize() reports
+// the instance's share of the setup.
+//
 // author: Kristian Timm Andersen
 
 class FFTReal : public AlgorithmImplementation<FFTConfiguration, FFTReal>
 {
   public:
     FFTReal(Coefficients c = Coefficients())
-        : BaseAlgorithm{c}, scale{1.f / static_cast<float>(C.fftSize)}, setup{std::shared_ptr<PFFFT_Setup>(pffftSmartCreate(C.fftSize), pffftSmartDestroy)}
+        : BaseAlgorithm{c}, scale{1.f / static_cast<float>(C.fftSize)}, setup{getSharedSetup(C.fftSize, PFFFT_REAL)}
     {
-        out.resize((int)C.fftSize);
-        if (!setup) { throw Configuration::ExceptionFFT(C.fftSize); }
-        assert(Configuration::isFFTSizeValid(
-            C.fftSize)); // assert that FFT size is valid. It is not extremely useful after the throwing exception, but it allows the exception to be caught in debug mode
+        if (!Configuration::isFFTSizeValid(C.fftSize)) { throw Configuration::ExceptionFFT(C.fftSize); }
+        if (setup) { out.resize(C.fftSize); }
+        else // FFT size is not supported by pffft so use Bluestein's algorithm
+        {
+            const int length = (C.fftSize % 2 == 0) ? C.fftSize / 2 : C.fftSize;
+            bluestein = FFTBluestein(length, getSharedSetup(FFTBluestein::getConvolutionSize(length), PFFFT_COMPLEX));
+            bluesteinBuffer.resize(length);
+            if (C.fftSize % 2 == 0)
+            {
+                // twiddle factors for splitting the transform of the even and odd samples: -i/2 * exp(-2i*pi*k/fftSize)
+                const Eigen::ArrayXd phase = Eigen::ArrayXd::LinSpaced(length, 0., -2 * 3.141592653589793 * (length - 1) / C.fftSize);
+                Eigen::ArrayXcd rotation(length);
+                rotation.real() = phase.cos();
+                rotation.imag() = phase.sin();
+                twiddles = (std::complex<double>(0., -.5) * rotation).cast<std::complex<float>>();
+            }
+        }
     }
 
     inline void inverse(I::Complex2D xFreq, O::Real2D yTime)
     {
+        if (!setup)
+        {
+            inverseBluestein(xFreq, yTime);
+            return;
+        }
         for (auto channel = 0; channel < xFreq.cols(); channel++)
         {
             yTime(0, channel) = xFreq(0, channel).real();
@@ -36,16 +65,83 @@ class FFTReal : public AlgorithmImplementation<FFTConfiguration, FFTReal>
         }
     }
 
+    // return pffft setup that is shared by all users of the same fftSize and transform type. Returns nullptr if size is not supported by pffft. Defined in fft.cpp
+    static std::shared_ptr<PFFFT_Setup> getSharedSetup(int fftSize, pffft_transform_t transform);
+
   private:
     inline void processAlgorithm(Input xTime, Output yFreq)
     {
-        // After the first channel, yFreq is not 16 byte alligned due to FFTSize/2+1 size so we can't write output to it from FFT transform
+        if (!setup)
+        {
+            processBluestein(xTime, yFreq);
+            return;
+        }
+        for (auto channel = 0; channel < xTime.cols(); channel++)
+        {
+            float *yChannel = reinterpret_cast<float *>(yFreq.col(channel).data());
+            if (reinterpret_cast<std::uintptr_t>(yChannel) % 16 == 0)
+            {
+                // ordered output is [DC, Nyquist, real(1), imag(1), ...], so only the Nyquist bin has to be moved to the last bin
+                pffft_transform_ordered(setup.get(), xTime.col(channel).data(), yChannel, nullptr, PFFFT_FORWARD);
+                yFreq(C.fftSize / 2, channel) = yChannel[1];
+                yChannel[1] = 0.f;
+            }
+            else // column is not 16 byte aligned, so the FFT can't write to it directly
+            {
+                pffft_transform_ordered(setup.get(), xTime.col(channel).data(), out.data(), nullptr, PFFFT_FORWARD);
+                yFreq(0, channel) = out(0);
+                yFreq(C.fftSize / 2, channel) = out(1);
+                std::memcpy(&yFreq.real()(1, channel), &out(2), (C.fftSize - 2) * sizeof(float));
+            }
+        }
+    }
+
+    void processBluestein(Input xTime, Output yFreq)
+    {
+        const int length = bluestein.getLength();
         for (auto channel = 0; channel < xTime.cols(); channel++)
         {
-            pffft_transform_ordered(setup.get(), xTime.col(channel).data(), out.data(), nullptr, PFFFT_FORWARD);
-            yFreq(0, channel) = out(0);
-            yFreq(C.fftSize / 2, channel) = out(1);
-            std::memcpy(&yFreq.real()(1, channel), &out(2), (C.fftSize - 2) * sizeof(float));
+            if (C.fftSize % 2 == 0)
+            {
+                // even and odd samples are the real and imaginary part of a complex signal of half length
+                bluestein.forward(reinterpret_cast<const std::complex<float> *>(xTime.col(channel).data()), bluesteinBuffer.data(), length);
+                yFreq(0, channel) = bluesteinBuffer(0).real() + bluesteinBuffer(0).imag();
+                yFreq(length, channel) = bluesteinBuffer(0).real() - bluesteinBuffer(0).imag();
+                auto z = bluesteinBuffer.tail(length - 1);
+                auto zConj = bluesteinBuffer.tail(length - 1).reverse().conjugate();
+                yFreq.col(channel).segment(1, length - 1) = .5f * (z + zConj) + twiddles.tail(length - 1) * (z - zConj);
+            }
+            else
+            {
+                bluesteinBuffer.real() = xTime.col(channel);
+                bluesteinBuffer.imag() = 0.f;
+                bluestein.forward(bluesteinBuffer.data(), yFreq.col(channel).data(), static_cast<int>(yFreq.rows()));
+            }
+        }
+    }
+
+    void inverseBluestein(I::Complex2D xFreq, O::Real2D yTime)
+    {
+        const int length = bluestein.getLength();
+        const int nBands = static_cast<int>(xFreq.rows());
+        for (auto channel = 0; channel < xFreq.cols(); channel++)
+        {
+            if (C.fftSize % 2 == 0)
+            {
+                // combine spectrum of even and odd samples into a complex spectrum of half length
+                auto x = xFreq.col(channel).head(length);
+                auto xConj = xFreq.col(channel).segment(1, length).reverse().conjugate();
+                bluesteinBuffer = .5f * (x + xConj) + twiddles.conjugate() * (x - xConj);
+                bluestein.inverse(bluesteinBuffer.data(), reinterpret_cast<std::complex<float> *>(yTime.col(channel).data()), length);
+                yTime.col(channel) *= 2 * scale;
+            }
+            else
+            {
+                bluesteinBuffer.head(nBands) = xFreq.col(channel);
+                bluesteinBuffer.tail(nBands - 1) = xFreq.col(channel).tail(nBands - 1).reverse().conjugate();
+                bluestein.inverse(bluesteinBuffer.data(), bluesteinBuffer.data(), length);
+                yTime.col(channel) = bluesteinBuffer.real() * scale;
+            }
         }
     }
 
@@ -58,17 +154,27 @@ class FFTReal : public AlgorithmImplementation<FFTConfiguration, FFTReal>
     size_t getDynamicSizeVariables() const final
     {
         size_t size = out.getDynamicMemorySize();
-        if (setup) { size += pffft_get_setup_size(setup.get()); }
+        size += bluestein.getDynamicMemorySize();
+        size += bluesteinBuffer.getDynamicMemorySize();
+        size += twiddles.getDynamicMemorySize();
         return size;
     }
 
+    size_t getSharedDynamicSizeVariables() const final
+    {
+        if (setup) { return pffft_get_setup_size(setup.get()) / setup.use_count(); }
+        return bluestein.getSharedDynamicMemorySize();
+    }
+
     // defined in fft.cpp
     static void pffftSmartDestroy(PFFFT_Setup *s);
-    static PFFFT_Setup *pffftSmartCreate(int fftSize);
+    static PFFFT_Setup *pffftSmartCreate(int fftSize, pffft_transform_t transform);
 
     float scale;
-    std::shared_ptr<PFFFT_Setup> setup;
+    std::shared_ptr<PFFFT_Setup> setup; // nullptr if FFT size is not supported by pffft
     Eigen::ArrayXf out;
+    FFTBluestein bluestein;
+    Eigen::ArrayXcf bluesteinBuffer, twiddles;
 
     friend BaseAlgorithm;
 };
@@ -49,6 +49,7 @@ bool isCoefficientsValid(const FilterbankConfiguration::Coefficients &c)
     {
     default: // Hann window is default case
     case FilterbankConfiguration::Coefficients::FilterbankTypes::HANN:
+    case FilterbankConfiguration::Coefficients::FilterbankTypes::LOW_DELAY:
         if ((factor < 2.f) || (factor != factorFloor)) { return false; } // Configuration not currently supported
         break;
     case FilterbankConfiguration::Coefficients::FilterbankTypes::SQRT_HANN:
@@ -71,6 +72,13 @@ Eigen::ArrayXf getAnalysisWindow(const FilterbankConfiguration::Coefficients &c)
     case FilterbankConfiguration::Coefficients::FilterbankTypes::HANN: window = hann(fftSize); break;
     case FilterbankConfiguration::Coefficients::FilterbankTypes::SQRT_HANN: window = hann(fftSize).sqrt(); break;
     case FilterbankConfiguration::Coefficients::FilterbankTypes::WOLA: window = sinc(2 * fftSize, 2) * kaiser(2 * fftSize, 10); break;
+    case FilterbankConfiguration::Coefficients::FilterbankTypes::LOW_DELAY:
+        // square root of asymmetric Hann window: rising half of a Hann window of length 2 * (fftSize - bufferSize) followed by falling half of a Hann window of length
+        // 2 * bufferSize
+        window.resize(fftSize);
+        window.head(fftSize - c.bufferSize) = hann(2 * (fftSize - c.bufferSize)).head(fftSize - c.bufferSize).sqrt();
+        window.tail(c.bufferSize) = hann(2 * c.bufferSize).tail(c.bufferSize).sqrt();
+        break;
     }
     return window;
 }
@@ -88,11 +96,18 @@ Eigen::ArrayXf getSynthesisWindow(const FilterbankConfiguration::Coefficients &c
         break;
     case FilterbankConfiguration::Coefficients::FilterbankTypes::SQRT_HANN: window = hann(fftSize).sqrt(); break;
     case FilterbankConfiguration::Coefficients::FilterbankTypes::WOLA: window = kaiser(2 * fftSize, 14); break;
+    case FilterbankConfiguration::Coefficients::FilterbankTypes::LOW_DELAY:
+    {
+        // synthesis window has length 2 * bufferSize and is chosen so the product with the end of the analysis window is a Hann window of length 2 * bufferSize
+        const Eigen::ArrayXf analysisEnd = getAnalysisWindow(c).tail(2 * c.bufferSize);
+        window = (analysisEnd > 0.f).select(hann(2 * c.bufferSize) / analysisEnd, 0.f);
+        break;
+    }
     }
 
-    // scale synthesis window to give unit output
+    // scale synthesis window to give unit output. The synthesis window is aligned with the end of the analysis window
     Eigen::ArrayXf windowSum = Eigen::ArrayXf::Zero(c.bufferSize);
-    Eigen::ArrayXf windowProd = window * getAnalysisWindow(c);
+    Eigen::ArrayXf windowProd = window * getAnalysisWindow(c).tail(window.size());
     for (auto i = 0; i < window.size() / c.bufferSize; i++)
     {
         windowSum += windowProd.segment(i * c.bufferSize, c.bufferSize);
@@ -107,4 +122,35 @@ float getDelaySamples(I::Real window)
     Eigen::ArrayXf ramp = Eigen::ArrayXf::LinSpaced(window.size(), 0, static_cast<float>(window.size() - 1));
     return (window * ramp).sum() / (window.sum() + 1e-12f);
 }
+
+// the LOW_DELAY windows are asymmetric, so the group delay of each window doesn't give the delay of the filterbank. Instead the delay is split equally between
+// analysis and synthesis like for a symmetric window pair of length 2 * bufferSize
+float getDelaySamples(const FilterbankConfiguration::Coefficients &c, I::Real window)
+{
+    if (c.filterbankType == FilterbankConfiguration::Coefficients::LOW_DELAY) { return static_cast<float>(c.bufferSize); }
+    return getDelaySamples(window);
+}
+
+void foldCircularBuffer(I::Real timeBuffer, int index, I::Real window, int bufferSize, O::Real fftBuffer)
+{
+    const int frameSize = static_cast<int>(timeBuffer.size());
+    const int fftSize = static_cast<int>(fftBuffer.size());
+    for (auto start = 0; start < frameSize; start += bufferSize)
+    {
+        auto block = timeBuffer.segment((index + start) % frameSize, bufferSize) * window.segment(start, bufferSize);
+        if (start < fftSize) { fftBuffer.segment(start, bufferSize) = block; }
+        else { fftBuffer.segment(start % fftSize, bufferSize) += block; }
+    }
+}
+
+void overlapAddCircularBuffer(I::Real fftBuffer, I::Real window, int bufferSize, int index, O::Real timeBuffer)
+{
+    const int frameSize = static_cast<int>(timeBuffer.size());
+    const int fftSize = static_cast<int>(fftBuffer.size());
+    const int offset = fftSize - frameSize % fftSize; // align end of frame with end of fftBuffer
+    for (auto start = 0; start < frameSize; start += bufferSize)
+    {
+        timeBuffer.segment((index + start) % frameSize, bufferSize) += fftBuffer.segment((offset + start) % fftSize, bufferSize) * window.segment(start, bufferSize);
+    }
+}
 }; // namespace FilterbankShared
\ No newline at end of file
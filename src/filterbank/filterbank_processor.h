@@ -0,0 +1,111 @@
+#pragma once
+#include "algorithm_library/filterbank.h"
+#include "fft/fft_real.h"
+#include "filterbank/filterbank_wola.h"
+#include "framework/framework.h"
+
+// Fused analysis and synthesis filterbank that calls a spectral function in between, one channel at a time.
+//
+// process(xTime, yTime, spectralFunction) calls spectralFunction(xFreq, channel) for each channel, where xFreq is an Eigen::ArrayXcf with nBands values that can be
+// modified in place. Since analysis, spectral function and synthesis are calculated for one channel before moving on to the next, the spectrum is still in cache
+// when it is synthesized and only a single-channel spectrum is stored. The spectral function can only depend on the current channel.
+//
+// process(xTime, yTime) without a spectral function reconstructs the input delayed by getDelaySamples().
+//
+// Both go through AlgorithmImplementation::process, so they are profiled and traced like other algorithms. The time of the spectral function, including member
+// algorithms of the caller that it calls, is part of the time of FilterbankProcessor.
+//
+// author: Kristian Timm Andersen
+
+struct FilterbankProcessorConfiguration : public FilterbankConfiguration
+{
+    using Input = I::Real2D;
+    using Output = O::Real2D;
+
+    static Eigen::ArrayXXf initInput(const Coefficients &c) { return Eigen::ArrayXXf::Random(c.bufferSize, c.nChannels); } // time samples
+
+    static Eigen::ArrayXXf initOutput(Input input, const Coefficients &c) { return Eigen::ArrayXXf::Zero(c.bufferSize, c.nChannels); } // time samples
+
+    static bool validInput(Input input, const Coefficients &c) { return (input.rows() == c.bufferSize) && (input.cols() == c.nChannels) && input.allFinite(); }
+
+    static bool validOutput(Output output, const Coefficients &c) { return (output.rows() == c.bufferSize) && (output.cols() == c.nChannels) && output.allFinite(); }
+};
+
+class FilterbankProcessor : public AlgorithmImplementation<FilterbankProcessorConfiguration, FilterbankProcessor>
+{
+  public:
+    FilterbankProcessor(Coefficients c = Coefficients()) : BaseAlgorithm{c}, fft({FFTConfiguration::convertNBandsToFFTSize(c.nBands)})
+    {
+        fftSize = FFTConfiguration::convertNBandsToFFTSize(c.nBands);
+        windowAnalysis = FilterbankShared::getAnalysisWindow(c);
+        windowSynthesis = FilterbankShared::getSynthesisWindow(c);
+        fftBuffer.resize(fftSize);
+        xFreq.resize(c.nBands);
+        analysisBuffer.resize(windowAnalysis.size(), c.nChannels);
+        synthesisBuffer.resize(windowSynthesis.size(), c.nChannels);
+
+        resetVariables();
+    }
+
+    FFTReal fft;
+    DEFINE_MEMBER_ALGORITHMS(fft)
+
+    int getFFTSize() const { return fftSize; }
+    int getNBands() const { return fftSize / 2 + 1; }
+
+    float getDelaySamples() const { return FilterbankShared::getDelaySamples(C, windowAnalysis) + FilterbankShared::getDelaySamples(C, windowSynthesis); }
+
+  private:
+    inline void processAlgorithm(Input xTime, Output yTime) { processAlgorithm(xTime, yTime, [](Eigen::ArrayXcf &, int) {}); }
+
+    // calculate analysis filterbank, spectralFunction(xFreq, channel) and synthesis filterbank for each channel
+    template <typename Tfunction>
+    inline void processAlgorithm(Input xTime, Output yTime, Tfunction &&spectralFunction)
+    {
+        // analysis and synthesis buffers are circular buffers, see FilterbankShared::foldCircularBuffer
+        analysisBuffer.middleRows(indexAnalysis, C.bufferSize) = xTime; // overwrite oldest block
+        indexAnalysis = (indexAnalysis + C.bufferSize) % static_cast<int>(analysisBuffer.rows());
+        for (auto channel = 0; channel < C.nChannels; channel++)
+        {
+            FilterbankShared::foldCircularBuffer(analysisBuffer.col(channel), indexAnalysis, windowAnalysis, C.bufferSize, fftBuffer);
+            fft.process(fftBuffer, xFreq);
+            spectralFunction(xFreq, channel);
+            fft.inverse(xFreq, fftBuffer);
+            FilterbankShared::overlapAddCircularBuffer(fftBuffer, windowSynthesis, C.bufferSize, indexSynthesis, synthesisBuffer.col(channel));
+        }
+        yTime = synthesisBuffer.middleRows(indexSynthesis, C.bufferSize); // oldest block is finished
+        synthesisBuffer.middleRows(indexSynthesis, C.bufferSize).setZero();
+        indexSynthesis = (indexSynthesis + C.bufferSize) % static_cast<int>(synthesisBuffer.rows());
+    }
+
+    bool isCoefficientsValid() const final { return FilterbankShared::isCoefficientsValid(C); }
+
+    size_t getDynamicSizeVariables() const final
+    {
+        auto size = windowAnalysis.getDynamicMemorySize();
+        size += windowSynthesis.getDynamicMemorySize();
+        size += fftBuffer.getDynamicMemorySize();
+        size += xFreq.getDynamicMemorySize();
+        size += analysisBuffer.getDynamicMemorySize();
+        size += synthesisBuffer.getDynamicMemorySize();
+        return size;
+    }
+
+    void resetVariables() final
+    {
+        fftBuffer.setZero();
+        xFreq.setZero();
+        analysisBuffer.setZero();
+        synthesisBuffer.setZero();
+        indexAnalysis = 0;
+        indexSynthesis = 0;
+    }
+
+    int fftSize;
+    int indexAnalysis, indexSynthesis; // start of the oldest block in the circular buffers
+    Eigen::ArrayXf windowAnalysis, windowSynthesis, fftBuffer;
+    Eigen::ArrayXcf xFreq;
+    Eigen::ArrayXXf analysisBuffer, synthesisBuffer;
+
+    friend BaseAlgorithm;
+};
@@ -19,10 +19,7 @@ class FilterbankAnalysisSingleChannel : public AlgorithmImplementation<Filterban
         fftSize = FFTConfiguration::convertNBandsToFFTSize(c.nBands);
         window = FilterbankShared::getAnalysisWindow(c);
         frameSize = static_cast<int>(window.size());
-        overlap = frameSize - C.bufferSize;
-        nFolds = static_cast<int>(std::ceil(static_cast<float>(frameSize) / fftSize));
-        maxSize = fftSize * nFolds;
-        fftBuffer.resize(maxSize);
+        fftBuffer.resize(fftSize);
         timeBuffer.resize(frameSize);
 
         resetVariables();
@@ -35,7 +32,7 @@ class FilterbankAnalysisSingleChannel : public AlgorithmImplementation<Filterban
     int getNBands() const { return fftSize / 2 + 1; }
     int getFrameSize() const { return frameSize; }
 
-    float getDelaySamples() const { return FilterbankShared::getDelaySamples(window); }
+    float getDelaySamples() const { return FilterbankShared::getDelaySamples(C, window); }
 
     // set window if length equals frameSize
     void setWindow(I::Real win)
@@ -52,14 +49,10 @@ class FilterbankAnalysisSingleChannel : public AlgorithmImplementation<Filterban
   private:
     inline void processAlgorithm(Input xTime, Output yFreq)
     {
-        timeBuffer.head(overlap) = timeBuffer.tail(overlap);
-        timeBuffer.tail(C.bufferSize) = xTime.col(0).head(C.bufferSize);
-        fftBuffer.head(frameSize) = timeBuffer * window;
-        for (auto j = 1; j < nFolds; j++)
-        {
-            fftBuffer.head(fftSize) += fftBuffer.segment(j * fftSize, fftSize);
-        }
-        fft.process(fftBuffer.head(fftSize), yFreq);
+        timeBuffer.segment(index, C.bufferSize) = xTime.col(0).head(C.bufferSize); // overwrite oldest block
+        index = (index + C.bufferSize) % frameSize;
+        FilterbankShared::foldCircularBuffer(timeBuffer, index, window, C.bufferSize, fftBuffer);
+        fft.process(fftBuffer, yFreq);
     }
 
     bool isCoefficientsValid() const final { return FilterbankShared::isCoefficientsValid(C); }
@@ -76,12 +69,13 @@ class FilterbankAnalysisSingleChannel : public AlgorithmImplementation<Filterban
     {
         fftBuffer.setZero();
         timeBuffer.setZero();
+        index = 0;
     }
 
     int frameSize, fftSize;
     Eigen::ArrayXf window, fftBuffer;
     Eigen::ArrayXf timeBuffer;
-    int overlap, nFolds, maxSize;
+    int index; // start of the oldest block in the circular timeBuffer
 
     friend BaseAlgorithm;
 };
@@ -98,10 +92,7 @@ class FilterbankSynthesisSingleChannel : public AlgorithmImplementation<Filterba
         fftSize = FFTConfiguration::convertNBandsToFFTSize(c.nBands);
         window = FilterbankShared::getSynthesisWindow(c);
         frameSize = static_cast<int>(window.size());
-        overlap = frameSize - C.bufferSize;
-        nFolds = static_cast<int>(std::ceil(static_cast<float>(frameSize) / fftSize));
-        maxSize = fftSize * nFolds;
-        fftBuffer.resize(maxSize);
+        fftBuffer.resize(fftSize);
         timeBuffer.resize(frameSize);
 
         resetVariables();
@@ -113,23 +104,19 @@ class FilterbankSynthesisSingleChannel : public AlgorithmImplementation<Filterba
     int getFFTSize() const { return fftSize; }
     int getNBands() const { return fftSize / 2 + 1; }
 
-    float getDelaySamples() const { return FilterbankShared::getDelaySamples(window); }
+    float getDelaySamples() const { return FilterbankShared::getDelaySamples(C, window); }
 
   private:
     inline void processAlgorithm(Input xFreq, Output yTime)
     {
         for (auto iFrame = 0; iFrame < xFreq.cols(); iFrame++)
         {
-            fft.inverse(xFreq.col(iFrame), fftBuffer.head(fftSize));
-            for (auto j = 1; j < nFolds; j++)
-            {
-                fftBuffer.segment(j * fftSize, fftSize) = fftBuffer.head(fftSize);
-            }
-            timeBuffer += fftBuffer.tail(frameSize) * window;
-
-            yTime.col(0).segment(iFrame * C.bufferSize, C.bufferSize) = timeBuffer.head(C.bufferSize);
-            timeBuffer.head(overlap) = timeBuffer.tail(overlap);
-            timeBuffer.tail(C.bufferSize) = 0.f;
+            fft.inverse(xFreq.col(iFrame), fftBuffer);
+            FilterbankShared::overlapAddCircularBuffer(fftBuffer, window, C.bufferSize, index, timeBuffer);
+
+            yTime.col(0).segment(iFrame * C.bufferSize, C.bufferSize) = timeBuffer.segment(index, C.bufferSize); // oldest block is finished
+            timeBuffer.segment(index, C.bufferSize).setZero();
+            index = (index + C.bufferSize) % frameSize;
         }
     }
 
@@ -147,12 +134,13 @@ class FilterbankSynthesisSingleChannel : public AlgorithmImplementation<Filterba
     {
         fftBuffer.setZero();
         timeBuffer.setZero();
+        index = 0;
     }
 
     int fftSize, frameSize;
     Eigen::ArrayXf window, fftBuffer;
     Eigen::ArrayXf timeBuffer;
-    int overlap, nFolds, maxSize;
+    int index; // start of the oldest block in the circular timeBuffer
 
     friend BaseAlgorithm;
 };
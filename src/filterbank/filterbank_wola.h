@@ -15,6 +15,17 @@ Eigen::ArrayXf getAnalysisWindow(const FilterbankConfiguration::Coefficients &c)
 Eigen::ArrayXf getSynthesisWindow(const FilterbankConfiguration::Coefficients &c);
 
 float getDelaySamples(I::Real window);
+
+float getDelaySamples(const FilterbankConfiguration::Coefficients &c, I::Real window);
+
+// The time buffers are circular buffers of frameSize samples, where index is the start of the oldest block of bufferSize samples. Frames are windowed and folded
+// directly from and to the circular buffer, so samples are never shifted. All supported configurations have frameSize and fftSize as integer multiples of bufferSize.
+
+// window the frame in timeBuffer that starts at index and fold it into fftBuffer of size fftSize
+void foldCircularBuffer(I::Real timeBuffer, int index, I::Real window, int bufferSize, O::Real fftBuffer);
+
+// window the periodically extended fftBuffer and add it to the frame in timeBuffer that starts at index. The end of the frame is aligned with the end of fftBuffer
+void overlapAddCircularBuffer(I::Real fftBuffer, I::Real window, int bufferSize, int index, O::Real timeBuffer);
 }; // namespace FilterbankShared
 
 // --------------------------------------------------- FilterbankAnalysis ----------------------------------------------------------------
@@ -27,10 +38,7 @@ class FilterbankAnalysisWOLA : public AlgorithmImplementation<FilterbankAnalysis
         fftSize = FFTConfiguration::convertNBandsToFFTSize(c.nBands);
         window = FilterbankShared::getAnalysisWindow(c);
         frameSize = static_cast<int>(window.size());
-        overlap = frameSize - C.bufferSize;
-        nFolds = static_cast<int>(std::ceil(static_cast<float>(frameSize) / fftSize));
-        maxSize = fftSize * nFolds;
-        fftBuffer.resize(maxSize);
+        fftBuffer.resize(fftSize);
         timeBuffer.resize(frameSize, c.nChannels);
 
         resetVariables();
@@ -43,7 +51,7 @@ class FilterbankAnalysisWOLA : public AlgorithmImplementation<FilterbankAnalysis
     int getNBands() const { return fftSize / 2 + 1; }
     int getFrameSize() const { return frameSize; }
 
-    float getDelaySamples() const { return FilterbankShared::getDelaySamples(window); }
+    float getDelaySamples() const { return FilterbankShared::getDelaySamples(C, window); }
 
     // set window if length equals frameSize
     void setWindow(I::Real win)
@@ -60,16 +68,12 @@ class FilterbankAnalysisWOLA : public AlgorithmImplementation<FilterbankAnalysis
   private:
     inline void processAlgorithm(Input xTime, Output yFreq)
     {
-        timeBuffer.topRows(overlap) = timeBuffer.bottomRows(overlap);
-        timeBuffer.bottomRows(C.bufferSize) = xTime;
+        timeBuffer.middleRows(index, C.bufferSize) = xTime; // overwrite oldest block
+        index = (index + C.bufferSize) % frameSize;
         for (auto channel = 0; channel < C.nChannels; channel++)
         {
-            fftBuffer.head(frameSize) = timeBuffer.col(channel) * window;
-            for (auto j = 1; j < nFolds; j++)
-            {
-                fftBuffer.head(fftSize) += fftBuffer.segment(j * fftSize, fftSize);
-            }
-            fft.process(fftBuffer.head(fftSize), yFreq.col(channel));
+            FilterbankShared::foldCircularBuffer(timeBuffer.col(channel), index, window, C.bufferSize, fftBuffer);
+            fft.process(fftBuffer, yFreq.col(channel));
         }
     }
 
@@ -87,12 +91,13 @@ class FilterbankAnalysisWOLA : public AlgorithmImplementation<FilterbankAnalysis
     {
         fftBuffer.setZero();
         timeBuffer.setZero();
+        index = 0;
     }
 
     int frameSize, fftSize;
     Eigen::ArrayXf window, fftBuffer;
     Eigen::ArrayXXf timeBuffer;
-    int overlap, nFolds, maxSize;
+    int index; // start of the oldest block in the circular timeBuffer
 
     friend BaseAlgorithm;
 };
@@ -107,10 +112,7 @@ class FilterbankSynthesisWOLA : public AlgorithmImplementation<FilterbankSynthes
         fftSize = FFTConfiguration::convertNBandsToFFTSize(c.nBands);
         window = FilterbankShared::getSynthesisWindow(c);
         frameSize = static_cast<int>(window.size());
-        overlap = frameSize - C.bufferSize;
-        nFolds = static_cast<int>(std::ceil(static_cast<float>(frameSize) / fftSize));
-        maxSize = fftSize * nFolds;
-        fftBuffer.resize(maxSize);
+        fftBuffer.resize(fftSize);
         timeBuffer.resize(frameSize, C.nChannels);
 
         resetVariables();
@@ -122,23 +124,19 @@ class FilterbankSynthesisWOLA : public AlgorithmImplementation<FilterbankSynthes
     int getFFTSize() const { return fftSize; }
     int getNBands() const { return fftSize / 2 + 1; }
 
-    float getDelaySamples() const { return FilterbankShared::getDelaySamples(window); }
+    float getDelaySamples() const { return FilterbankShared::getDelaySamples(C, window); }
 
   private:
     inline void processAlgorithm(Input xFreq, Output yTime)
     {
         for (auto channel = 0; channel < C.nChannels; channel++)
         {
-            fft.inverse(xFreq.col(channel), fftBuffer.head(fftSize));
-            for (auto j = 1; j < nFolds; j++)
-            {
-                fftBuffer.segment(j * fftSize, fftSize) = fftBuffer.head(fftSize);
-            }
-            timeBuffer.col(channel) += (fftBuffer.tail(frameSize) * window);
+            fft.inverse(xFreq.col(channel), fftBuffer);
+            FilterbankShared::overlapAddCircularBuffer(fftBuffer, window, C.bufferSize, index, timeBuffer.col(channel));
         }
-        yTime = timeBuffer.topRows(C.bufferSize);
-        timeBuffer.topRows(overlap) = timeBuffer.bottomRows(overlap);
-        timeBuffer.bottomRows(C.bufferSize) = 0.f;
+        yTime = timeBuffer.middleRows(index, C.bufferSize); // oldest block is finished
+        timeBuffer.middleRows(index, C.bufferSize).setZero();
+        index = (index + C.bufferSize) % frameSize;
     }
 
     bool isCoefficientsValid() const final { return FilterbankShared::isCoefficientsValid(C); }
@@ -155,12 +153,13 @@ class FilterbankSynthesisWOLA : public AlgorithmImplementation<FilterbankSynthes
     {
         fftBuffer.setZero();
         timeBuffer.setZero();
+        index = 0;
     }
 
     int fftSize, frameSize;
     Eigen::ArrayXf window, fftBuffer;
     Eigen::ArrayXXf timeBuffer;
-    int overlap, nFolds, maxSize;
+    int index; // start of the oldest block in the circular timeBuffer
 
     friend BaseAlgorithm;
 };
@@ -0,0 +1,29 @@
+#include "fir_filter/fir_filter_partitioned.h"
+#include "fir_filter/fir_filter_time_domain.h"
+
+template <>
+void Algorithm<FIRFilterConfiguration>::setImplementation(const Coefficients &c)
+{
+    if (c.filterLength <= FIRFilterConfiguration::FILTER_LENGTH_TIME_DOMAIN_MAX) { pimpl = std::make_unique<Implementation<FIRFilterTimeDomain, FIRFilterConfiguration>>(c); }
+    else { pimpl = std::make_unique<Implementation<FIRFilterPartitioned, FIRFilterConfiguration>>(c); }
+}
+
+FIRFilter::FIRFilter(const Coefficients &c) : Algorithm<FIRFilterConfiguration>(c) {}
+
+void FIRFilter::setFilter(I::Real filter)
+{
+    if (getCoefficients().filterLength <= FIRFilterConfiguration::FILTER_LENGTH_TIME_DOMAIN_MAX)
+    {
+        static_cast<Implementation<FIRFilterTimeDomain, FIRFilterConfiguration> *>(pimpl.get())->algo.setFilter(filter);
+    }
+    else { static_cast<Implementation<FIRFilterPartitioned, FIRFilterConfiguration> *>(pimpl.get())->algo.setFilter(filter); }
+}
+
+Eigen::ArrayXf FIRFilter::getFilter() const
+{
+    if (getCoefficients().filterLength <= FIRFilterConfiguration::FILTER_LENGTH_TIME_DOMAIN_MAX)
+    {
+        return static_cast<Implementation<FIRFilterTimeDomain, FIRFilterConfiguration> *>(pimpl.get())->algo.getFilter();
+    }
+    else { return static_cast<Implementation<FIRFilterPartitioned, FIRFilterConfiguration> *>(pimpl.get())->algo.getFilter(); }
+}
@@ -0,0 +1,115 @@
+#pragma once
+#include "algorithm_library/fir_filter.h"
+#include "fft/fft_real.h"
+#include "framework/framework.h"
+#include "utilities/pffft.h"
+
+// FIR filter calculated with uniformly partitioned overlap-save convolution.
+//
+// The filter is split into partitions of bufferSize samples that are transformed once in setFilter(). Each buffer, the spectrum of the latest fftSize input
+// samples is stored in a frequency-domain delay line and multiplied with the partitions using pffft_zconvolve_accumulate, so only one forward and one inverse FFT
+// are calculated per channel and buffer. Spectra are kept in the internal pffft order, since they are never read outside pffft.
+//
+// fftSize is the smallest size calculated natively by pffft that is at least 2*bufferSize, and the FFT setup is shared with FFTReal.
+//
+// author: Kristian Timm Andersen
+
+class FIRFilterPartitioned : public AlgorithmImplementation<FIRFilterConfiguration, FIRFilterPartitioned>
+{
+  public:
+    FIRFilterPartitioned(Coefficients c = Coefficients())
+        : BaseAlgorithm{c}, fftSize(FFTConfiguration::getValidFFTSize(2 * C.bufferSize)), nPartitions((C.filterLength + C.bufferSize - 1) / C.bufferSize),
+          setup(FFTReal::getSharedSetup(fftSize, PFFFT_REAL))
+    {
+        inputBuffer.resize(fftSize, C.nChannels);
+        inputSpectra.resize(fftSize, nPartitions * C.nChannels);
+        filterSpectra.resize(fftSize, nPartitions);
+        outputSpectrum.resize(fftSize);
+        outputBuffer.resize(fftSize);
+        work.resize(fftSize);
+
+        filter = Eigen::ArrayXf::Zero(C.filterLength);
+        filter(0) = 1.f;
+        setFilter(filter);
+        resetVariables();
+    }
+
+    // set filter if length is less than or equal to filterLength
+    void setFilter(I::Real filterIn)
+    {
+        if (filterIn.size() > C.filterLength) { return; }
+
+        filter.head(filterIn.size()) = filterIn;
+        filter.tail(C.filterLength - filterIn.size()).setZero();
+        for (auto partition = 0; partition < nPartitions; partition++)
+        {
+            const int length = std::min(C.bufferSize, C.filterLength - partition * C.bufferSize);
+            outputBuffer.setZero();
+            outputBuffer.head(length) = filter.segment(partition * C.bufferSize, length);
+            pffft_transform(setup.get(), outputBuffer.data(), filterSpectra.col(partition).data(), work.data(), PFFFT_FORWARD);
+        }
+    }
+
+    Eigen::ArrayXf getFilter() const { return filter; }
+
+  private:
+    inline void processAlgorithm(Input xTime, Output yTime)
+    {
+        const int overlap = fftSize - C.bufferSize;
+        const float scale = 1.f / fftSize;
+        for (auto channel = 0; channel < C.nChannels; channel++)
+        {
+            inputBuffer.col(channel).head(overlap) = inputBuffer.col(channel).tail(overlap);
+            inputBuffer.col(channel).tail(C.bufferSize) = xTime.col(channel);
+
+            const int offset = channel * nPartitions;
+            pffft_transform(setup.get(), inputBuffer.col(channel).data(), inputSpectra.col(offset + index).data(), work.data(), PFFFT_FORWARD);
+
+            // partition p is multiplied with the input spectrum from p buffers ago
+            outputSpectrum.setZero();
+            for (auto partition = 0; partition < nPartitions; partition++)
+            {
+                const int delayed = (index - partition + nPartitions) % nPartitions;
+                pffft_zconvolve_accumulate(setup.get(), inputSpectra.col(offset + delayed).data(), filterSpectra.col(partition).data(), outputSpectrum.data(), scale);
+            }
+            pffft_transform(setup.get(), outputSpectrum.data(), outputBuffer.data(), work.data(), PFFFT_BACKWARD);
+            yTime.col(channel) = outputBuffer.tail(C.bufferSize);
+        }
+        index = (index + 1) % nPartitions;
+    }
+
+    bool isCoefficientsValid() const final { return (C.nChannels > 0) && (C.bufferSize > 0) && (C.filterLength > 0) && setup; }
+
+    size_t getDynamicSizeVariables() const final
+    {
+        size_t size = filter.getDynamicMemorySize();
+        size += inputBuffer.getDynamicMemorySize();
+        size += inputSpectra.getDynamicMemorySize();
+        size += filterSpectra.getDynamicMemorySize();
+        size += outputSpectrum.getDynamicMemorySize();
+        size += outputBuffer.getDynamicMemorySize();
+        size += work.getDynamicMemorySize();
+        return size;
+    }
+
+    size_t getSharedDynamicSizeVariables() const final
+    {
+        if (setup) { return pffft_get_setup_size(setup.get()) / setup.use_count(); }
+        return 0;
+    }
+
+    void resetVariables() final
+    {
+        inputBuffer.setZero();
+        inputSpectra.setZero();
+        index = 0;
+    }
+
+    int fftSize, nPartitions;
+    std::shared_ptr<PFFFT_Setup> setup;
+    int index; // position of the newest input spectrum in the frequency-domain delay line
+    Eigen::ArrayXf filter, outputSpectrum, outputBuffer, work;
+    Eigen::ArrayXXf inputBuffer, inputSpectra, filterSpectra;
+
+    friend BaseAlgorithm;
+};
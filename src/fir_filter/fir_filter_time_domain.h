@@ -0,0 +1,63 @@
+#pragma once
+#include "algorithm_library/fir_filter.h"
+#include "framework/framework.h"
+
+// FIR filter calculated directly in the time domain. This is the most efficient implementation for short filters.
+//
+// author: Kristian Timm Andersen
+
+class FIRFilterTimeDomain : public AlgorithmImplementation<FIRFilterConfiguration, FIRFilterTimeDomain>
+{
+  public:
+    FIRFilterTimeDomain(Coefficients c = Coefficients()) : BaseAlgorithm{c}
+    {
+        filter = Eigen::ArrayXf::Zero(C.filterLength);
+        filter(0) = 1.f;
+        buffer.resize(C.filterLength - 1 + C.bufferSize, C.nChannels);
+        resetVariables();
+    }
+
+    // set filter if length is less than or equal to filterLength
+    void setFilter(I::Real filterIn)
+    {
+        if (filterIn.size() <= C.filterLength)
+        {
+            filter.setZero();
+            filter.head(filterIn.size()) = filterIn;
+        }
+    }
+
+    Eigen::ArrayXf getFilter() const { return filter; }
+
+  private:
+    inline void processAlgorithm(Input xTime, Output yTime)
+    {
+        const int history = C.filterLength - 1;
+        buffer.bottomRows(C.bufferSize) = xTime;
+        for (auto channel = 0; channel < C.nChannels; channel++)
+        {
+            yTime.col(channel) = filter(0) * buffer.col(channel).tail(C.bufferSize);
+            for (auto i = 1; i < C.filterLength; i++)
+            {
+                yTime.col(channel) += filter(i) * buffer.col(channel).segment(history - i, C.bufferSize);
+            }
+        }
+        buffer.topRows(history) = buffer.bottomRows(history);
+    }
+
+    bool isCoefficientsValid() const final { return (C.nChannels > 0) && (C.bufferSize > 0) && (C.filterLength > 0); }
+
+    size_t getDynamicSizeVariables() const final
+    {
+        size_t size = filter.getDynamicMemorySize();
+        size += buffer.getDynamicMemorySize();
+        return size;
+    }
+
+    void resetVariables() final { buffer.setZero(); }
+
+    Eigen::ArrayXf filter;
+    Eigen::ArrayXXf buffer;
+
+    friend BaseAlgorithm;
+};
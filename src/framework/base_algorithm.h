@@ -2,6 +2,8 @@
 #include "algorithm_library/interface/input_output.h"
 #include "algorithm_library/interface/macros_json.h"
 #include "algorithm_library/interface/public_algorithm.h"
+#include "profiling.h"
+#include "tracing.h"
 
 template <typename Talgo, typename Tconfiguration>
 struct Implementation : public Algorithm<Tconfiguration>::BaseImplementation
@@ -25,6 +27,7 @@ struct Implementation : public Algorithm<Tconfiguration>::BaseImplementation
         return j;
     }
     void setDebugJson(const nlohmann::json &s) final { algo.setSetupTree(s); }
+    nlohmann::json getProfileTree() const final { return algo.getProfileTree(); }
     bool isConfigurationValid() const final { return algo.isConfigurationValid(); }
 
     bool validInput(typename Tconfiguration::Input input) const final { return algo.validInput(input); }
@@ -79,6 +82,7 @@ struct BufferImplementation : public AlgorithmBuffer<Tconfiguration>::BufferBase
         return j;
     }
     void setDebugJson(const nlohmann::json &s) final { algo.setSetupTree(s); }
+    nlohmann::json getProfileTree() const final { return algo.getProfileTree(); }
     bool isConfigurationValid() const final { return algo.isConfigurationValid(); }
 
     bool validInput(typename Tconfiguration::Input input) const final { return algo.validInput(input); }
@@ -187,10 +191,20 @@ class AlgorithmImplementation
 
     size_t getDynamicSize() const { return getDynamicSizeVariables() + getDynamicSizeAlgorithms(); }
 
+    // dynamic memory that is shared with other instances (e.g. FFT setups). Each instance reports its share, so the sum over all instances is the total shared memory
+    size_t getSharedDynamicSize() const { return getSharedDynamicSizeVariables() + getSharedDynamicSizeAlgorithms(); }
+
     // Processing method. This is where the core of the algorithm is calculated.
     // When profiling using MSVC compiler it was found that CRTP is faster than virtual methods.
     // However, using GCC it was found that virtual methods are as fast as CRTP (maybe because the virtual methods in header files can be inlined?).
-    inline void process(Input input, Output output) { static_cast<Talgo &>(*this).processAlgorithm(input, output); }
+    inline void process(Input input, Output output) { processInstrumented(input, output); }
+
+    // processing method with additional arguments that are forwarded to processAlgorithm, e.g. the spectral function of FilterbankProcessor
+    template <typename Targument, typename... Targuments>
+    inline void process(Input input, Output output, Targument &&argument, Targuments &&...arguments)
+    {
+        processInstrumented(input, output, std::forward<Targument>(argument), std::forward<Targuments>(arguments)...);
+    }
 
     // templated process functions that allows to call process with tuples
     template <typename... TupleTypes>
@@ -217,6 +231,23 @@ class AlgorithmImplementation
         resetAlgorithms();
     }
 
+    // timings of process() in this algorithm and its member algorithms (see profiling.h). The timings are reset when the coefficients are set
+    nlohmann::json getProfileTree() const
+    {
+#ifdef ALGORITHM_LIBRARY_PROFILING
+        nlohmann::json j = profile.toJson();
+        nlohmann::json members = getProfileTreeAlgorithms();
+        if (!members.empty())
+        {
+            Profiling::addShareOfParent(members, j["totalMicroseconds"].get<double>());
+            j["members"] = members;
+        }
+        return j;
+#else
+        return nlohmann::json::object();
+#endif
+    }
+
     static constexpr size_t ALGORITHM_VERSION_MINOR = 1; // version changes in implementation
 
     Coefficients getCoefficients() const { return C; }
@@ -312,11 +343,16 @@ class AlgorithmImplementation
     // these functions will be overridden if defined in derived Talgo
     virtual size_t getDynamicSizeVariables() const { return 0; }
     virtual size_t getDynamicSizeAlgorithms() const { return 0; }
+    virtual size_t getSharedDynamicSizeVariables() const { return 0; }
+    virtual size_t getSharedDynamicSizeAlgorithms() const { return 0; }
     virtual void resetVariables() {}
     virtual void resetAlgorithms() {}
     virtual bool isCoefficientsValid() const { return true; }
     virtual bool isParametersValid() const { return true; }
     virtual bool isAlgorithmsValid() const { return true; }
+#ifdef ALGORITHM_LIBRARY_PROFILING
+    virtual nlohmann::json getProfileTreeAlgorithms() const { return nlohmann::json::object(); }
+#endif
     void onParametersChanged() {} // If more advanced functionality is needed, then write your own setters but remember to call the setters from this function.
 
     // these functions will be hidden if macro DEFINE_STATIC_MEMBER_ALGORITHMS(...) or DEFINE_SIMPLE_MEMBER_ALGORITHMS(...) is declared in derived Talgo
@@ -331,6 +367,26 @@ class AlgorithmImplementation
     Parameters P;
 
   private:
+#ifdef ALGORITHM_LIBRARY_PROFILING
+    Profiling::ProfileData profile;
+#endif
+
+    // call processAlgorithm and record the call if profiling (see profiling.h) or tracing (see tracing.h) is enabled
+    template <typename... Targuments>
+    inline void processInstrumented(Input input, Output output, Targuments &&...arguments)
+    {
+#ifdef ALGORITHM_LIBRARY_TRACING
+        Tracing::Scope traceScope(typeid(Talgo).name());
+#endif
+#ifdef ALGORITHM_LIBRARY_PROFILING
+        const uint64_t start = Profiling::readTimer();
+#endif
+        static_cast<Talgo &>(*this).processAlgorithm(input, output, std::forward<Targuments>(arguments)...);
+#ifdef ALGORITHM_LIBRARY_PROFILING
+        profile.add(Profiling::readTimer() - start);
+#endif
+    }
+
     // template implementations that allow to call methods with tuples
     template <typename TupleType, std::size_t... Is>
     void processImpl(const TupleType &input, std::index_sequence<Is...>, Output output)
@@ -175,13 +175,67 @@
         SELECT_SET_MEMBER_METHOD(setSetupTree, Setup, __VA_ARGS__)                                                                                                            \
     }
 
+#define PROFILE_MEMBER_10(member, ...)                                                                                                                                        \
+    j[#member] = member.getProfileTree();                                                                                                                                     \
+    EVAL(EVAL(PROFILE_MEMBER_9)(__VA_ARGS__))
+#define PROFILE_MEMBER_9(member, ...)                                                                                                                                         \
+    j[#member] = member.getProfileTree();                                                                                                                                     \
+    EVAL(EVAL(PROFILE_MEMBER_8)(__VA_ARGS__))
+#define PROFILE_MEMBER_8(member, ...)                                                                                                                                         \
+    j[#member] = member.getProfileTree();                                                                                                                                     \
+    EVAL(EVAL(PROFILE_MEMBER_7)(__VA_ARGS__))
+#define PROFILE_MEMBER_7(member, ...)                                                                                                                                         \
+    j[#member] = member.getProfileTree();                                                                                                                                     \
+    EVAL(EVAL(PROFILE_MEMBER_6)(__VA_ARGS__))
+#define PROFILE_MEMBER_6(member, ...)                                                                                                                                         \
+    j[#member] = member.getProfileTree();                                                                                                                                     \
+    EVAL(EVAL(PROFILE_MEMBER_5)(__VA_ARGS__))
+#define PROFILE_MEMBER_5(member, ...)                                                                                                                                         \
+    j[#member] = member.getProfileTree();                                                                                                                                     \
+    EVAL(EVAL(PROFILE_MEMBER_4)(__VA_ARGS__))
+#define PROFILE_MEMBER_4(member, ...)                                                                                                                                         \
+    j[#member] = member.getProfileTree();                                                                                                                                     \
+    EVAL(EVAL(PROFILE_MEMBER_3)(__VA_ARGS__))
+#define PROFILE_MEMBER_3(member, ...)                                                                                                                                         \
+    j[#member] = member.getProfileTree();                                                                                                                                     \
+    EVAL(EVAL(PROFILE_MEMBER_2)(__VA_ARGS__))
+#define PROFILE_MEMBER_2(member, ...)                                                                                                                                         \
+    j[#member] = member.getProfileTree();                                                                                                                                     \
+    EVAL(EVAL(PROFILE_MEMBER_1)(__VA_ARGS__))
+#define PROFILE_MEMBER_1(member) j[#member] = member.getProfileTree();
+
+#define SELECT_PROFILE_MEMBER(...)                                                                                                                                            \
+    EVAL(GET_NUMBER_OF_ARGUMENTS(__VA_ARGS__, PROFILE_MEMBER_10, PROFILE_MEMBER_9, PROFILE_MEMBER_8, PROFILE_MEMBER_7, PROFILE_MEMBER_6, PROFILE_MEMBER_5, PROFILE_MEMBER_4,  \
+                                 PROFILE_MEMBER_3, PROFILE_MEMBER_2, PROFILE_MEMBER_1)(__VA_ARGS__))
+
+// Example of DEFINE_MEMBER_PROFILE_TREE(Algorithm1, Algorithm2) when ALGORITHM_LIBRARY_PROFILING is defined:
+//
+// nlohmann::json getProfileTreeAlgorithms() const final {
+//     nlohmann::json j;
+//     j["Algorithm1"] = Algorithm1.getProfileTree(); j["Algorithm2"] = Algorithm2.getProfileTree();
+//     return j;
+// }
+#ifdef ALGORITHM_LIBRARY_PROFILING
+#define DEFINE_MEMBER_PROFILE_TREE(...)                                                                                                                                       \
+    nlohmann::json getProfileTreeAlgorithms() const final                                                                                                                     \
+    {                                                                                                                                                                         \
+        nlohmann::json j;                                                                                                                                                     \
+        SELECT_PROFILE_MEMBER(__VA_ARGS__)                                                                                                                                    \
+        return j;                                                                                                                                                             \
+    }
+#else
+#define DEFINE_MEMBER_PROFILE_TREE(...)
+#endif
+
 #define DEFINE_MEMBER_ALGORITHMS(...)                                                                                                                                         \
     DEFINE_MEMBER_SET_GET_FUNCTIONS(Parameters, parameters, __VA_ARGS__)                                                                                                      \
     DEFINE_MEMBER_SET_GET_FUNCTIONS(Coefficients, coefficients, __VA_ARGS__)                                                                                                  \
     DEFINE_MEMBER_SETUP_SET_GET_FUNCTIONS(__VA_ARGS__)                                                                                                                        \
     size_t getDynamicSizeAlgorithms() const final { return SELECT_APPLY_MEMBER_METHOD(EVAL(getDynamicSize() +), __VA_ARGS__) 0; }                                             \
+    size_t getSharedDynamicSizeAlgorithms() const final { return SELECT_APPLY_MEMBER_METHOD(EVAL(getSharedDynamicSize() +), __VA_ARGS__) 0; }                                 \
     void resetAlgorithms() final { SELECT_APPLY_MEMBER_METHOD(EVAL(reset();), __VA_ARGS__) }                                                                                  \
-    bool isAlgorithmsValid() const final { return SELECT_APPLY_MEMBER_METHOD(EVAL(isConfigurationValid() &&), __VA_ARGS__) true; }
+    bool isAlgorithmsValid() const final { return SELECT_APPLY_MEMBER_METHOD(EVAL(isConfigurationValid() &&), __VA_ARGS__) true; }                                            \
+    DEFINE_MEMBER_PROFILE_TREE(__VA_ARGS__)
 
 #define DEFINE_ALGORITHM_CONSTRUCTOR(PublicAlgorithm, InternalAlgorithm, ConfigurationName)                                                                                   \
     using InternalAlgorithm##SingleBufferImpl = Implementation<InternalAlgorithm, ConfigurationName>;                                                                         \
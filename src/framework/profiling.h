@@ -0,0 +1,97 @@
+#pragma once
+#include "nlohmann/json.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+// Profiling of process() in all algorithms. If ALGORITHM_LIBRARY_PROFILING is defined (CMake option of the same name), every algorithm times its calls to process()
+// with a low-overhead timer, and getProfileTree() returns the timings of the algorithm and all member algorithms declared with DEFINE_MEMBER_ALGORITHMS as a json
+// tree. If ALGORITHM_LIBRARY_PROFILING is not defined, nothing is timed and getProfileTree() returns an empty json object.
+//
+// The timer is the time stamp counter on x86, the virtual counter on ARM64 and std::chrono::steady_clock on other platforms. A member algorithm is only timed when its
+// process() is called, so time spent in other methods of a member (e.g. FFTReal::inverse) is included in the parent, but not listed as a member.
+//
+// author: Kristian Timm Andersen
+
+namespace Profiling
+{
+
+inline uint64_t readTimer()
+{
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86)) || defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#elif defined(__aarch64__)
+    uint64_t ticks;
+    asm volatile("mrs %0, cntvct_el0" : "=r"(ticks));
+    return ticks;
+#else
+    return static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+#endif
+}
+
+// The frequency of the time stamp counter is not available on x86, so it is measured against steady_clock the first time this function is called
+inline double getTicksPerSecond()
+{
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86)) || defined(__x86_64__) || defined(__i386__)
+    static const double ticksPerSecond = [] {
+        const auto start = std::chrono::steady_clock::now();
+        const uint64_t startTicks = readTimer();
+        auto end = start;
+        while (end - start < std::chrono::milliseconds(20))
+        {
+            end = std::chrono::steady_clock::now();
+        }
+        const uint64_t endTicks = readTimer();
+        return static_cast<double>(endTicks - startTicks) / std::chrono::duration<double>(end - start).count();
+    }();
+    return ticksPerSecond;
+#elif defined(__aarch64__)
+    uint64_t frequency;
+    asm volatile("mrs %0, cntfrq_el0" : "=r"(frequency));
+    return static_cast<double>(frequency);
+#else
+    return static_cast<double>(std::chrono::steady_clock::period::den) / std::chrono::steady_clock::period::num;
+#endif
+}
+
+struct ProfileData
+{
+    uint64_t nCalls = 0;
+    uint64_t totalTicks = 0;
+    uint64_t maxTicks = 0;
+
+    void add(uint64_t ticks)
+    {
+        nCalls++;
+        totalTicks += ticks;
+        maxTicks = std::max(maxTicks, ticks);
+    }
+
+    nlohmann::json toJson() const
+    {
+        const double microsecondsPerTick = 1e6 / getTicksPerSecond();
+        nlohmann::json j;
+        j["calls"] = nCalls;
+        j["totalMicroseconds"] = totalTicks * microsecondsPerTick;
+        j["averageMicroseconds"] = nCalls > 0 ? totalTicks * microsecondsPerTick / nCalls : 0.;
+        j["maxMicroseconds"] = maxTicks * microsecondsPerTick;
+        return j;
+    }
+};
+
+// add the share of the parent time to each member profile. The share can be larger than 100% if a member is also called outside of the parent's process()
+inline void addShareOfParent(nlohmann::json &members, double parentMicroseconds)
+{
+    for (auto &member : members)
+    {
+        if (member.is_array()) { addShareOfParent(member, parentMicroseconds); } // VectorAlgo
+        else if (parentMicroseconds > 0) { member["percentOfParent"] = 100. * member["totalMicroseconds"].get<double>() / parentMicroseconds; }
+    }
+}
+
+} // namespace Profiling
@@ -0,0 +1,182 @@
+#include "algorithm_library/tracing.h"
+#include "framework/tracing.h"
+#include "nlohmann/json.hpp"
+#include <chrono>
+#include <fstream>
+#include <thread>
+#include <unordered_map>
+#if defined(__GNUG__)
+#include <cstdlib>
+#include <cxxabi.h>
+#endif
+
+#ifdef ALGORITHM_LIBRARY_TRACING
+
+namespace
+{
+
+// owns the event buffer of a registered thread and releases it when the thread exits
+struct ThreadRegistration
+{
+    ~ThreadRegistration()
+    {
+        if (buffer)
+        {
+            Tracing::getThreadBuffer() = nullptr;
+            Tracing::getRegistry().releaseBuffer(buffer);
+        }
+    }
+
+    std::shared_ptr<Tracing::EventBuffer> buffer;
+};
+
+// moves events from the buffers of all threads to the trace file
+class TraceWriter
+{
+  public:
+    TraceWriter() { Tracing::getRegistry(); } // construct the registry first, so it is destroyed after the writer
+    ~TraceWriter() { stop(); }
+
+    bool start(const std::string &filename)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (thread.joinable()) { return false; }
+        file.open(filename);
+        if (!file) { return false; }
+
+        file << "{\"traceEvents\":[";
+        firstEvent = true;
+        microsecondsPerTick = 1e6 / Profiling::getTicksPerSecond();
+        referenceTicks = Profiling::readTimer();
+        running = true;
+        Tracing::getRegistry().setTraceRunning(true);
+        Tracing::getRegistry().enabled = true;
+        thread = std::thread([this] {
+            while (running)
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+                flush();
+            }
+        });
+        return true;
+    }
+
+    void stop()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!thread.joinable()) { return; }
+        Tracing::getRegistry().enabled = false;
+        running = false;
+        thread.join();
+        flush();
+
+        // the threads that have exited were named when their buffers were freed
+        for (auto &buffer : Tracing::getRegistry().getBuffers())
+        {
+            writeThreadName(*buffer);
+        }
+        Tracing::getRegistry().setTraceRunning(false);
+        file << "]}\n";
+        file.close();
+    }
+
+  private:
+    void flush()
+    {
+        for (auto &buffer : Tracing::getRegistry().getBuffers())
+        {
+            const bool released = buffer->isReleased(); // read before the events, so all events of a thread that has exited are written before its buffer is freed
+            buffer->pop([&](const Tracing::Event &event) {
+                // events that started before the trace or were left in the buffer by a previous trace are discarded
+                if (event.startTicks < referenceTicks) { return; }
+                write({{"name", getName(event.name)},
+                       {"ph", "X"}, // complete event with start time and duration
+                       {"pid", 1},
+                       {"tid", buffer->getThreadId()},
+                       {"ts", (event.startTicks - referenceTicks) * microsecondsPerTick},
+                       {"dur", (event.endTicks - event.startTicks) * microsecondsPerTick}});
+            });
+            if (released)
+            {
+                writeThreadName(*buffer);
+                Tracing::getRegistry().removeBuffer(buffer);
+            }
+        }
+        file.flush();
+    }
+
+    // name the thread and report dropped events
+    void writeThreadName(Tracing::EventBuffer &buffer)
+    {
+        std::string threadName = "thread " + std::to_string(buffer.getThreadId());
+        const uint64_t nDropped = buffer.getAndResetNDropped();
+        if (nDropped > 0) { threadName += " (" + std::to_string(nDropped) + " events dropped)"; }
+        write({{"name", "thread_name"}, {"ph", "M"}, {"pid", 1}, {"tid", buffer.getThreadId()}, {"args", {{"name", threadName}}}});
+    }
+
+    void write(const nlohmann::json &event)
+    {
+        if (!firstEvent) { file << ",\n"; }
+        firstEvent = false;
+        file << event.dump();
+    }
+
+    const std::string &getName(const char *mangledName)
+    {
+        auto it = names.find(mangledName);
+        if (it != names.end()) { return it->second; }
+        std::string name = mangledName;
+#if defined(__GNUG__)
+        int status;
+        char *demangled = abi::__cxa_demangle(mangledName, nullptr, nullptr, &status);
+        if (status == 0) { name = demangled; }
+        std::free(demangled);
+#endif
+        return names.emplace(mangledName, name).first->second;
+    }
+
+    std::mutex mutex;
+    std::thread thread;
+    std::atomic<bool> running{false};
+    std::ofstream file;
+    bool firstEvent;
+    double microsecondsPerTick;
+    uint64_t referenceTicks;
+    std::unordered_map<const char *, std::string> names; // cache of demangled names
+};
+
+TraceWriter &getTraceWriter()
+{
+    static TraceWriter writer;
+    return writer;
+}
+
+} // namespace
+
+namespace Tracing
+{
+bool start(const std::string &filename) { return getTraceWriter().start(filename); }
+void stop() { getTraceWriter().stop(); }
+
+bool registerThread()
+{
+    thread_local ThreadRegistration registration;
+    if (!registration.buffer)
+    {
+        registration.buffer = getRegistry().addBuffer();
+        getThreadBuffer() = registration.buffer.get();
+    }
+    return true;
+}
+} // namespace Tracing
+
+#else
+
+namespace Tracing
+{
+bool start(const std::string &filename) { return false; }
+void stop() {}
+bool registerThread() { return false; }
+} // namespace Tracing
+
+#endif
@@ -0,0 +1,169 @@
+#pragma once
+#include "profiling.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <typeinfo>
+#include <vector>
+
+// Timeline tracing of process() in all algorithms. If ALGORITHM_LIBRARY_TRACING is defined (CMake option of the same name), every call to process() is recorded as an event
+// with its start and end time, while a trace is running (see algorithm_library/tracing.h). Each processing thread writes its events to its own lock-free ring buffer, and a
+// background thread moves the events to a Chrome trace JSON file, which can be opened in Perfetto (ui.perfetto.dev) or chrome://tracing. Calls to member algorithms are
+// nested inside the call of the parent algorithm on the timeline. If a ring buffer is full, the event is dropped and counted.
+//
+// The ring buffer of a thread is allocated by Tracing::registerThread(), so recording an event never locks or allocates, and calls to process() from threads that are not
+// registered are not recorded. When a registered thread exits, its buffer is released and freed after the writer has written its events.
+//
+// If ALGORITHM_LIBRARY_TRACING is not defined, nothing is recorded. If it is defined and no trace is running, the cost is one atomic load per call to process().
+//
+// author: Kristian Timm Andersen
+
+namespace Tracing
+{
+
+struct Event
+{
+    const char *name; // typeid(Talgo).name(), which is demangled when the event is written to the file
+    uint64_t startTicks;
+    uint64_t endTicks;
+};
+
+// ring buffer with a single producer (the processing thread) and a single consumer (the writer thread)
+class EventBuffer
+{
+  public:
+    EventBuffer(int threadId) : threadId(threadId) {}
+
+    void push(const Event &event)
+    {
+        const uint32_t write = writeIndex.load(std::memory_order_relaxed);
+        if (write - readIndex.load(std::memory_order_acquire) >= SIZE)
+        {
+            nDropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        events[write % SIZE] = event;
+        writeIndex.store(write + 1, std::memory_order_release);
+    }
+
+    // call function f for all events in the buffer and remove them
+    template <typename Function>
+    void pop(Function f)
+    {
+        uint32_t read = readIndex.load(std::memory_order_relaxed);
+        const uint32_t write = writeIndex.load(std::memory_order_acquire);
+        for (; read != write; read++)
+        {
+            f(events[read % SIZE]);
+        }
+        readIndex.store(read, std::memory_order_release);
+    }
+
+    int getThreadId() const { return threadId; }
+    uint64_t getAndResetNDropped() { return nDropped.exchange(0, std::memory_order_relaxed); }
+
+    // called by the thread when it exits, after its last event
+    void release() { released.store(true, std::memory_order_release); }
+    bool isReleased() const { return released.load(std::memory_order_acquire); }
+
+  private:
+    static constexpr uint32_t SIZE = 1 << 14; // number of events. Must be a power of 2, so the indices can wrap around
+    std::array<Event, SIZE> events;
+    std::atomic<uint32_t> writeIndex{0};
+    std::atomic<uint32_t> readIndex{0};
+    std::atomic<uint64_t> nDropped{0};
+    std::atomic<bool> released{false};
+    const int threadId;
+};
+
+// the event buffers of all registered threads
+class Registry
+{
+  public:
+    std::shared_ptr<EventBuffer> addBuffer()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        nThreads++;
+        buffers.push_back(std::make_shared<EventBuffer>(nThreads));
+        return buffers.back();
+    }
+
+    std::vector<std::shared_ptr<EventBuffer>> getBuffers()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return buffers;
+    }
+
+    // called when a registered thread exits. If a trace is running, the buffer is freed by the writer after its events have been written, otherwise it is freed now
+    void releaseBuffer(const std::shared_ptr<EventBuffer> &buffer)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        buffer->release();
+        if (!traceRunning) { buffers.erase(std::remove(buffers.begin(), buffers.end(), buffer), buffers.end()); }
+    }
+
+    void removeBuffer(const std::shared_ptr<EventBuffer> &buffer)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        buffers.erase(std::remove(buffers.begin(), buffers.end(), buffer), buffers.end());
+    }
+
+    // set by the writer. When the trace stops, the buffers of threads that have exited during the trace are freed
+    void setTraceRunning(bool running)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        traceRunning = running;
+        if (!traceRunning)
+        {
+            buffers.erase(std::remove_if(buffers.begin(), buffers.end(), [](const std::shared_ptr<EventBuffer> &buffer) { return buffer->isReleased(); }), buffers.end());
+        }
+    }
+
+    std::atomic<bool> enabled{false};
+
+  private:
+    std::mutex mutex;
+    std::vector<std::shared_ptr<EventBuffer>> buffers;
+    int nThreads = 0;
+    bool traceRunning = false; // protected by mutex
+};
+
+inline Registry &getRegistry()
+{
+    static Registry registry;
+    return registry;
+}
+
+inline bool isEnabled() { return getRegistry().enabled.load(std::memory_order_relaxed); }
+
+// the buffer of the calling thread, or nullptr if the thread is not registered. The buffer is owned by the registration in Tracing::registerThread(), and this is a raw
+// pointer with constant initialization, so reading it from process() doesn't construct a thread_local object, which can lock and allocate
+inline EventBuffer *&getThreadBuffer()
+{
+    thread_local EventBuffer *buffer = nullptr;
+    return buffer;
+}
+
+// record an event from construction to destruction
+class Scope
+{
+  public:
+    Scope(const char *name) : name(name), active(isEnabled() && getThreadBuffer())
+    {
+        if (active) { startTicks = Profiling::readTimer(); }
+    }
+
+    ~Scope()
+    {
+        if (active && isEnabled()) { getThreadBuffer()->push({name, startTicks, Profiling::readTimer()}); }
+    }
+
+  private:
+    const char *name;
+    bool active;
+    uint64_t startTicks = 0;
+};
+
+} // namespace Tracing
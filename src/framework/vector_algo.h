@@ -34,6 +34,16 @@ class VectorAlgo
         return size;
     }
 
+    size_t getSharedDynamicSize() const
+    {
+        size_t size = 0;
+        for (auto &element : vec)
+        {
+            size += element.getSharedDynamicSize();
+        }
+        return size;
+    }
+
     static size_t getStaticSize() { return sizeof(VectorAlgo); }
 
     void reset()
@@ -44,6 +54,16 @@ class VectorAlgo
         }
     }
 
+    nlohmann::json getProfileTree() const
+    {
+        nlohmann::json j = nlohmann::json::array();
+        for (auto &element : vec)
+        {
+            j.push_back(element.getProfileTree());
+        }
+        return j;
+    }
+
     bool isConfigurationValid() const
     {
         bool flag = true;
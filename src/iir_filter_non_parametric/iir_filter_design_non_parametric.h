@@ -17,15 +17,17 @@ class IIRFilterTDFNonParametric : public AlgorithmImplementation<IIRFilterNonPar
         : BaseAlgorithm{c}, filterDesignerNonParametric({.nBands = FFTConfiguration::convertFFTSizeToNBands(FFTConfiguration::getValidFFTSize(c.nSos * 16)),
                                                          .nGains = c.nSos,
                                                          .sampleRate = c.sampleRate}) // nBands must be significantly higher than the filter order
-    {}
+    {
+        sos.resize(6, c.nSos);
+    }
 
     DesignIIRSpline filterDesignerNonParametric;
     IIRFilterCascaded filter;
     DEFINE_MEMBER_ALGORITHMS(filter, filterDesignerNonParametric)
 
+    // setFilter doesn't allocate memory, so it can be called from the processing thread
     void setFilter(I::Real frequencies, I::Real gains)
     {
-        Eigen::ArrayXXf sos(6, C.nSos);
         float gain;
         filterDesignerNonParametric.process({frequencies, gains}, {sos, gain});
         filter.setFilter(sos, gain);
@@ -38,6 +40,10 @@ class IIRFilterTDFNonParametric : public AlgorithmImplementation<IIRFilterNonPar
   private:
     inline void processAlgorithm(Input input, Output output) { filter.process(input, output); }
 
+    size_t getDynamicSizeVariables() const final { return sos.getDynamicMemorySize(); }
+
+    Eigen::ArrayXXf sos;
+
     friend BaseAlgorithm;
 };
 
@@ -54,21 +60,19 @@ class IIRFilterSVFNonParametric : public AlgorithmImplementation<IIRFilterNonPar
         gain = Eigen::ArrayXf::Ones(c.nSos);
         cutoff = Eigen::ArrayXf::Constant(c.nSos, std::tan(3.14158f * 0.25f)); // tan(pi * f / fs)
         resonance = Eigen::ArrayXf::Constant(c.nSos, .7071f);                  // 1/sqrt(2) = 0.7071 corresponds to a Butterworth filter
+        sos.resize(6, c.nSos);
     }
 
     DesignIIRSpline filterDesignerNonParametric;
     StateVariableFilterCascade filter;
     DEFINE_MEMBER_ALGORITHMS(filter, filterDesignerNonParametric)
 
+    // setFilter doesn't allocate memory, so it can be called from the processing thread
     void setFilter(I::Real frequencies, I::Real gains)
     {
-        Eigen::ArrayXXf sos(6, C.nSos);
         float g;
         filterDesignerNonParametric.process({frequencies, gains}, {sos, g});
-        Eigen::Array3Xf cgr = filter.setUserDefinedSosFilter(sos);
-        cutoff = cgr.row(0).transpose();
-        gain = cgr.row(1).transpose();
-        resonance = cgr.row(2).transpose();
+        filter.setUserDefinedSosFilter(sos, cutoff, gain, resonance);
         filter.setGain(g);
     }
 
@@ -84,12 +88,14 @@ class IIRFilterSVFNonParametric : public AlgorithmImplementation<IIRFilterNonPar
         size_t size = cutoff.getDynamicMemorySize();
         size += gain.getDynamicMemorySize();
         size += resonance.getDynamicMemorySize();
+        size += sos.getDynamicMemorySize();
         return size;
     }
 
     Eigen::ArrayXf cutoff;
     Eigen::ArrayXf gain;
     Eigen::ArrayXf resonance;
+    Eigen::ArrayXXf sos;
 
     friend BaseAlgorithm;
 };
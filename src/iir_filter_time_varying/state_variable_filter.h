@@ -228,6 +228,18 @@ class StateVariableFilterCascade : public AlgorithmImplementation<IIRFilterCasca
         return cgr;
     }
 
+    // same as above, but cutoff, gain and resonance are written to preallocated arrays, so no memory is allocated
+    void setUserDefinedSosFilter(I::Real2D sos, O::Real cutoffs, O::Real gains, O::Real resonances)
+    {
+        for (auto i = 0; i < C.nSos; i++)
+        {
+            const Eigen::Array3f cgr = filters[i].setUserDefinedSosFilter(sos.col(i));
+            cutoffs(i) = cgr(0);
+            gains(i) = cgr(1);
+            resonances(i) = cgr(2);
+        }
+    }
+
   private:
     inline void processAlgorithm(Input input, Output output)
     {
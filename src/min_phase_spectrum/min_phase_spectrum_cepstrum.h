@@ -2,6 +2,7 @@
 #include "algorithm_library/min_phase_spectrum.h"
 #include "fft/fft_real.h"
 #include "framework/framework.h"
+#include "utilities/vector_math.h"
 
 // Calculate complex-valued minimum phase spectrum from a magnitude spectrum.
 //
@@ -23,21 +24,19 @@ class MinPhaseSpectrumCepstrum : public AlgorithmImplementation<MinPhaseSpectrum
   private:
     inline void processAlgorithm(Input magnitude, Output spectrum)
     {
-        using namespace std::complex_literals;
-
         for (auto channel = 0; channel < magnitude.cols(); channel++)
         {
             // calculate cepstrum
-            xLog = magnitude.col(channel).max(P.minMagnitude).log().cast<std::complex<float>>();
+            xCepstrum.head(C.nBands) = magnitude.col(channel).max(P.minMagnitude); // xCepstrum is used as temporary buffer
+            VectorMath::log(xCepstrum.head(C.nBands), xCepstrum.head(C.nBands));
+            xLog = xCepstrum.head(C.nBands).cast<std::complex<float>>();
             fft.inverse(xLog, xCepstrum);
             // fold
             xCepstrum.segment(1, C.nBands - 2) += xCepstrum.segment(C.nBands, C.nBands - 2).colwise().reverse();
             xCepstrum.segment(C.nBands, C.nBands - 2) = 0.f;
             // convert back
             fft.process(xCepstrum, xLog);
-            spectrum.col(channel) =
-                xLog.real().exp() *
-                (xLog.imag().cos() + 1.if * xLog.imag().sin()); // complex exponential exp(x+iy) = exp(x)*(cos(y)+i*sin(y)) is much faster according to profiling
+            VectorMath::expComplex(xLog, spectrum.col(channel)); // complex exponential exp(x+iy) = exp(x)*(cos(y)+i*sin(y))
         }
     }
 
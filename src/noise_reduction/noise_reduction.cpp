@@ -1,14 +1,22 @@
 #include "noise_reduction/noise_reduction_apriori.h"
 #include "noise_reduction/noise_reduction_ml.h"
+#include "noise_reduction/noise_reduction_ml_async.h"
+#include "noise_reduction/noise_reduction_ml_native.h"
 
 using AprioriImpl = Implementation<NoiseReductionAPriori, NoiseReductionConfiguration>;
 using MLImpl = Implementation<NoiseReductionML, NoiseReductionConfiguration>;
+using MLNativeImpl = Implementation<NoiseReductionMLNative, NoiseReductionConfiguration>;
+using MLAsyncImpl = Implementation<NoiseReductionMLAsync, NoiseReductionConfiguration>;
 
 template <>
 void Algorithm<NoiseReductionConfiguration>::setImplementation(const Coefficients &c)
 {
     if (c.algorithmType == c.APRIORI) { pimpl = std::make_unique<AprioriImpl>(c); }
-    else { pimpl = std::make_unique<MLImpl>(c); }
+    else if (c.inferenceMode == c.ASYNCHRONOUS) { pimpl = std::make_unique<MLAsyncImpl>(c); }
+    else if (c.algorithmType == c.ML) { pimpl = std::make_unique<MLImpl>(c); }
+    else { pimpl = std::make_unique<MLNativeImpl>(c); }
 }
 
-NoiseReduction::NoiseReduction(const Coefficients &c) : Algorithm<NoiseReductionConfiguration>(c) {}
\ No newline at end of file
+NoiseReduction::NoiseReduction(const Coefficients &c) : Algorithm<NoiseReductionConfiguration>(c) {}
+
+int NoiseReduction::getDelayFrames() const { return NoiseReductionConfiguration::getDelayFrames(getCoefficients()); }
\ No newline at end of file
@@ -0,0 +1,71 @@
+#pragma once
+#include "algorithm_library/noise_reduction.h"
+#include "framework/framework.h"
+#include "noise_reduction/noise_reduction_ml.h"
+#include "noise_reduction/noise_reduction_ml_native.h"
+#include "utilities/async_inference.h"
+#include <memory>
+
+// ML noise reduction where the model runs on a worker thread, so the time of the inference and its jitter are not in the call to process. process() applies the
+// gain of the previous frame to the previous input, which delays the output by 1 frame. If the inference of the previous frame is not finished in time, the
+// previous gain is held and the current frame is queued, so the recurrent state of the model still sees every frame. Frames are only dropped if the worker falls
+// more than AsyncInference::nFramesQueue frames behind. The model is NoiseReductionML or NoiseReductionMLNative depending on algorithmType.
+//
+// Without deadline misses the output is equal to the synchronous output delayed by 1 frame (see unit test).
+//
+// author: Kristian Timm Andersen
+class NoiseReductionMLAsync : public AlgorithmImplementation<NoiseReductionConfiguration, NoiseReductionMLAsync>
+{
+  public:
+    NoiseReductionMLAsync(const Coefficients &c = {.nBands = 257, .nChannels = 1, .algorithmType = Coefficients::ML_NATIVE, .inferenceMode = Coefficients::ASYNCHRONOUS})
+        : BaseAlgorithm{c}
+    {
+        Coefficients cModel = c;
+        cModel.inferenceMode = Coefficients::SYNCHRONOUS;
+        if (C.algorithmType == Coefficients::ML) { inferenceML = std::make_unique<AsyncInference<NoiseReductionML>>(cModel); }
+        else { inferenceNative = std::make_unique<AsyncInference<NoiseReductionMLNative>>(cModel); }
+    }
+
+    // block until the model has finished the last frame. This is not real-time safe
+    void waitForInference() const
+    {
+        if (inferenceML) { inferenceML->waitForInference(); }
+        else { inferenceNative->waitForInference(); }
+    }
+
+    // number of frames where the gain of the previous frame was not ready in time
+    int getDeadlineMisses() const { return inferenceML ? inferenceML->getDeadlineMisses() : inferenceNative->getDeadlineMisses(); }
+
+    // number of frames that the model never processed, because it was too far behind
+    int getDroppedFrames() const { return inferenceML ? inferenceML->getDroppedFrames() : inferenceNative->getDroppedFrames(); }
+
+  private:
+    // the inference is on the heap, so the worker thread is not affected when this algorithm is moved in setCoefficients
+    std::unique_ptr<AsyncInference<NoiseReductionML>> inferenceML;
+    std::unique_ptr<AsyncInference<NoiseReductionMLNative>> inferenceNative;
+
+    void processAlgorithm(Input xFreq, Output yFreq)
+    {
+        if (inferenceML) { inferenceML->process(xFreq, yFreq); }
+        else { inferenceNative->process(xFreq, yFreq); }
+    }
+
+    size_t getDynamicSizeVariables() const final { return inferenceML ? inferenceML->getDynamicMemorySize() : inferenceNative->getDynamicMemorySize(); }
+
+    void resetVariables() final
+    {
+        if (inferenceML) { inferenceML->reset(); }
+        else { inferenceNative->reset(); }
+    }
+
+    bool isCoefficientsValid() const final
+    {
+        bool flag = (C.algorithmType == C.ML) || (C.algorithmType == C.ML_NATIVE) || (C.algorithmType == C.ML_NATIVE_INT8);
+        flag &= C.inferenceMode == C.ASYNCHRONOUS;
+        flag &= C.nBands == 257;
+        flag &= C.nChannels >= 1;
+        return flag;
+    }
+
+    friend BaseAlgorithm;
+};
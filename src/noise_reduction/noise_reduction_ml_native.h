@@ -0,0 +1,462 @@
+#pragma once
+#include "algorithm_library/noise_reduction.h"
+#include "framework/framework.h"
+#include "utilities/onnx_initializers.h"
+#include "utilities/onnx_model.h"
+#include "utilities/vector_math.h"
+#include <algorithm>
+#include <array>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Noise reduction using the pp2model.onnx network implemented natively instead of with ONNX Runtime. The weights are read from the ONNX file once and shared by
+// all instances, and each channel is an independent stream with its own recurrent states (time buffer and GRU states). The model is found by
+// ONNXModel::readModel() in the same way as NoiseReductionML finds it, so it can be registered from memory with ONNXModel::registerModel() or placed in the
+// directory set by ONNXModel::setModelDirectory(). There is no graph to optimize, so ONNXModel::setOptimizedModelDirectory() is not used.
+//
+// The network is, for each frame:
+// - the magnitude and phase of the current and the 5 previous frames are encoded separately by a 1x1 convolution, layer normalization and PReLU
+// - 2 dilated dense nets that each have 4 sequential convolutions along frequency (kernel size 3, dilation 1, 2, 4, 8) and a final convolution of the input
+//   concatenated with the output of the last block. Between them, the features are projected from 257 bands to 64, processed by 2 GRU layers where the 64
+//   projections are the batch, and projected back to 257 bands and added to the output of the first dense net
+// - a 1x1 convolution to a single channel followed by a sigmoid, which gives a gain between 0 and 2
+//
+// Every layer is a matrix product on a (channels x bands) activation, so Eigen calculates the layers with its SIMD matrix kernels (SSE, AVX, AVX512 or NEON
+// depending on compile flags). A convolution with kernel size 3 is 3 matrix products on shifted columns, so no im2col buffer is needed. All buffers are allocated
+// in the constructor. The output is equal to NoiseReductionML up to floating point rounding (see unit test).
+//
+// With ML_NATIVE_INT8 the weights are read from pp2model_int8.onnx, which is made by libs/onnx/quantize_model.py. The weights are int8 with a scale for each
+// output channel and the activations are float. This reduces the memory of the shared weights from about 400 kB to 100 kB, and the weights are converted to
+// float in small blocks right before they are used. The relative error of the output compared to float weights is about -37 dB (see unit test).
+//
+// author: Kristian Timm Andersen
+class NoiseReductionMLNative : public AlgorithmImplementation<NoiseReductionConfiguration, NoiseReductionMLNative>
+{
+  public:
+    NoiseReductionMLNative(const Coefficients &c = {.nBands = 257, .nChannels = 1, .algorithmType = Coefficients::ML_NATIVE})
+        : BaseAlgorithm{c}, weights(getWeights(c.algorithmType == Coefficients::ML_NATIVE_INT8 ? "pp2model_int8.onnx" : "pp2model.onnx"))
+    {
+        magnitude.resize(C.nBands, nFrames * C.nChannels);
+        phase.resize(C.nBands, nFrames * C.nChannels);
+        gru1States.resize(C.nChannels, Eigen::MatrixXf::Zero(nBatch, nHidden));
+        gru2States.resize(C.nChannels, Eigen::MatrixXf::Zero(nBatch, nHidden));
+        gain.resize(C.nBands, C.nChannels);
+
+        encoderInput.resize(2 * nFrames, C.nBands);
+        denseNetInput.resize(2 * nFeatures, C.nBands);
+        denseNetOutput.resize(nFeatures, C.nBands);
+        features.resize(nFeatures, C.nBands);
+        featuresTemp.resize(nFeatures, C.nBands);
+        projection.resize(nFeatures, nBatch);
+        gatesInput.resize(nBatch, 3 * nHidden);
+        gatesState.resize(nBatch, 3 * nHidden);
+        gruOutput.resize(nBatch, nHidden);
+        rowMean.resize(nBatch);
+        rowScale.resize(nBatch);
+        if (C.algorithmType == Coefficients::ML_NATIVE_INT8) { dequantized.resize(nDequantized); }
+        resetVariables();
+    }
+
+    // gain that was applied in the last call to process
+    const Eigen::ArrayXXf &getGain() const { return gain; }
+
+  private:
+    // weight matrix that is either float or int8 with a scale for each output channel. Int8 weights are converted to float in blocks of columns that fit in the
+    // dequantized buffer when they are used, so the weights that are read from memory are 4 times smaller than float weights
+    struct WeightMatrix
+    {
+        Eigen::MatrixXf values; // float weights. Empty if the weights are int8
+        Eigen::Matrix<int8_t, Eigen::Dynamic, Eigen::Dynamic> valuesInt8;
+        Eigen::VectorXf scales; // scale for each row if the weights are the left operand and for each column if they are the right operand
+        bool isQuantized() const { return valuesInt8.size() > 0; }
+    };
+
+    // convolution along the frequency axis followed by layer normalization over frequency and PReLU for each output channel
+    struct ConvLayer
+    {
+        std::vector<WeightMatrix> kernel; // (nOutputs x nInputs) matrix for each kernel tap
+        Eigen::VectorXf bias, slope;
+        Eigen::RowVectorXf normWeight, normBias;
+        int dilation = 1;
+    };
+
+    // GRU with linear_before_reset = 1 and the gates in the order update, reset, hidden. The weights are transposed, since the batch is the rows
+    struct GRULayer
+    {
+        WeightMatrix inputWeights, stateWeights; // (nInputs x 3 * nHidden) and (nHidden x 3 * nHidden)
+        Eigen::RowVectorXf inputBias, stateBias;
+        Eigen::RowVectorXf normWeight, normBias; // layer normalization of the output
+        Eigen::VectorXf slope;                   // PReLU of the output for each batch
+    };
+
+    struct Weights
+    {
+        ConvLayer magnitudeEncoder, phaseEncoder, expander;
+        std::array<ConvLayer, 5> denseNet1, denseNet2; // 4 dilated blocks and the final layer
+        WeightMatrix projectionWeights;                 // (nBands x nBatch)
+        Eigen::RowVectorXf projectionBias, projectionNormWeight, projectionNormBias;
+        Eigen::VectorXf projectionSlope;
+        GRULayer gru1, gru2;
+        WeightMatrix expansionWeights; // (nBatch x nBands)
+        Eigen::RowVectorXf expansionBias, expansionNormWeight, expansionNormBias, residualNormWeight, residualNormBias;
+        Eigen::VectorXf expansionSlope, residualSlope;
+        ConvLayer denseConv;
+        Eigen::VectorXf contractorSlope;
+        Eigen::RowVectorXf contractorNormWeight, contractorNormBias;
+        WeightMatrix contractorWeights; // (nFeatures x 1)
+        float contractorBias;
+    };
+
+    static constexpr int nFrames = 6;    // current and previous frames that are input to the encoders
+    static constexpr int nEncoded = 6;   // channels out of each encoder
+    static constexpr int nFeatures = 32; // channels in the dense nets
+    static constexpr int nBatch = 64;    // frequency projections that are the batch of the GRUs
+    static constexpr int nHidden = 32;   // GRU hidden size
+    static constexpr int nDequantized = nBatch * nBatch; // size of the buffer that int8 weights are converted to
+
+    std::shared_ptr<const Weights> weights;
+    Eigen::ArrayXXf magnitude, phase; // circular buffers of nFrames for each channel
+    std::vector<Eigen::MatrixXf> gru1States, gru2States;
+    Eigen::ArrayXXf gain;
+    int frameIndex; // index of the current frame in the circular buffers
+
+    Eigen::MatrixXf encoderInput, denseNetInput, denseNetOutput, features, featuresTemp, projection, gatesInput, gatesState, gruOutput;
+    Eigen::VectorXf rowMean, rowScale, dequantized;
+
+    void processAlgorithm(Input xFreq, Output yFreq)
+    {
+        frameIndex = (frameIndex + 1) % nFrames;
+        for (auto channel = 0; channel < C.nChannels; channel++)
+        {
+            magnitude.col(channel * nFrames + frameIndex) = xFreq.col(channel).abs2();
+            VectorMath::arg(xFreq.col(channel), phase.col(channel * nFrames + frameIndex));
+            processChannel(channel);
+        }
+        yFreq = gain * xFreq;
+    }
+
+    void processChannel(int channel)
+    {
+        const Weights &w = *weights;
+
+        // encoders, where input channel i is frame i back in time
+        for (auto i = 0; i < nFrames; i++)
+        {
+            const int column = channel * nFrames + (frameIndex - i + nFrames) % nFrames;
+            encoderInput.row(i) = magnitude.col(column).transpose();
+            encoderInput.row(nFrames + i) = phase.col(column).transpose();
+        }
+        convolution(w.magnitudeEncoder, encoderInput.topRows(nFrames), featuresTemp.topRows(nEncoded));
+        convolution(w.phaseEncoder, encoderInput.bottomRows(nFrames), featuresTemp.middleRows(nEncoded, nEncoded));
+        convolution(w.expander, featuresTemp.topRows(2 * nEncoded), denseNetInput.topRows(nFeatures));
+        denseNet(w.denseNet1, features);
+
+        // project 257 bands to 64 and run the GRUs with the projections as batch
+        multiply(features, w.projectionWeights, projection);
+        projection.rowwise() += w.projectionBias;
+        layerNorm(projection, w.projectionNormWeight, w.projectionNormBias);
+        prelu(projection, w.projectionSlope);
+        multiply(projection.transpose(), w.gru1.inputWeights, gatesInput);
+        gru(w.gru1, gru1States[channel]);
+        multiply(gruOutput, w.gru2.inputWeights, gatesInput);
+        gru(w.gru2, gru2States[channel]);
+
+        // project back to 257 bands and add to the output of the first dense net
+        multiply(gruOutput.transpose(), w.expansionWeights, featuresTemp);
+        featuresTemp.rowwise() += w.expansionBias;
+        prelu(featuresTemp, w.expansionSlope);
+        layerNorm(featuresTemp, w.expansionNormWeight, w.expansionNormBias);
+        featuresTemp += features;
+        prelu(featuresTemp, w.residualSlope);
+        layerNorm(featuresTemp, w.residualNormWeight, w.residualNormBias);
+
+        convolution(w.denseConv, featuresTemp, denseNetInput.topRows(nFeatures));
+        denseNet(w.denseNet2, features);
+
+        prelu(features, w.contractorSlope);
+        layerNorm(features, w.contractorNormWeight, w.contractorNormBias);
+        multiply(features.transpose(), w.contractorWeights, Eigen::Map<Eigen::MatrixXf>(gain.col(channel).data(), C.nBands, 1));
+        gain.col(channel) = 2.f / (1.f + (-gain.col(channel) - w.contractorBias).exp());
+    }
+
+    // the input is in the top rows of denseNetInput. The blocks alternate between denseNetOutput and featuresTemp, and the last block writes to the bottom rows of
+    // denseNetInput, so it is concatenated with the input
+    void denseNet(const std::array<ConvLayer, 5> &layers, Eigen::MatrixXf &output)
+    {
+        convolution(layers[0], denseNetInput.topRows(nFeatures), denseNetOutput);
+        convolution(layers[1], denseNetOutput, featuresTemp);
+        convolution(layers[2], featuresTemp, denseNetOutput);
+        convolution(layers[3], denseNetOutput, denseNetInput.bottomRows(nFeatures));
+        convolution(layers[4], denseNetInput, output);
+    }
+
+    // convolution with zero padding, so the output has the same number of bands as the input
+    void convolution(const ConvLayer &layer, Eigen::Ref<const Eigen::MatrixXf> input, Eigen::Ref<Eigen::MatrixXf> output)
+    {
+        const int nBands = static_cast<int>(input.cols());
+        const int center = static_cast<int>(layer.kernel.size()) / 2;
+        output.colwise() = layer.bias;
+        for (auto tap = 0; tap < static_cast<int>(layer.kernel.size()); tap++)
+        {
+            const int offset = (tap - center) * layer.dilation;
+            const int start = std::max(-offset, 0);
+            const int n = nBands - std::abs(offset);
+            multiplyAdd(layer.kernel[tap], input.middleCols(start + offset, n), output.middleCols(start, n));
+        }
+        layerNorm(output, layer.normWeight, layer.normBias);
+        prelu(output, layer.slope);
+    }
+
+    // the input gates must be calculated in gatesInput before calling this function. The new state is normalized and written to gruOutput
+    void gru(const GRULayer &layer, Eigen::MatrixXf &state)
+    {
+        gatesInput.rowwise() += layer.inputBias;
+        multiply(state, layer.stateWeights, gatesState);
+        gatesState.rowwise() += layer.stateBias;
+        auto gates = gatesInput.array();
+        auto gatesS = gatesState.array();
+        gates.leftCols(2 * nHidden) = 1.f / (1.f + (-gates.leftCols(2 * nHidden) - gatesS.leftCols(2 * nHidden)).exp()); // update and reset gates
+        gates.rightCols(nHidden) = (gates.rightCols(nHidden) + gates.middleCols(nHidden, nHidden) * gatesS.rightCols(nHidden)).tanh();
+        state.array() = gates.rightCols(nHidden) + gates.leftCols(nHidden) * (state.array() - gates.rightCols(nHidden));
+        gruOutput = state;
+        layerNorm(gruOutput, layer.normWeight, layer.normBias);
+        prelu(gruOutput, layer.slope);
+    }
+
+    // output += weights * input
+    template <typename TInput>
+    void multiplyAdd(const WeightMatrix &weights, const Eigen::MatrixBase<TInput> &input, Eigen::Ref<Eigen::MatrixXf> output)
+    {
+        if (!weights.isQuantized())
+        {
+            output.noalias() += weights.values * input;
+            return;
+        }
+        const int nRows = static_cast<int>(weights.valuesInt8.rows());
+        const int nCols = static_cast<int>(weights.valuesInt8.cols());
+        const int blockSize = nDequantized / nRows;
+        for (auto column = 0; column < nCols; column += blockSize)
+        {
+            const int n = std::min(blockSize, nCols - column);
+            Eigen::Map<Eigen::MatrixXf> block(dequantized.data(), nRows, n);
+            block = weights.valuesInt8.middleCols(column, n).cast<float>();
+            block.array().colwise() *= weights.scales.array();
+            output.noalias() += block * input.middleRows(column, n);
+        }
+    }
+
+    // output = input * weights
+    template <typename TInput>
+    void multiply(const Eigen::MatrixBase<TInput> &input, const WeightMatrix &weights, Eigen::Ref<Eigen::MatrixXf> output)
+    {
+        if (!weights.isQuantized())
+        {
+            output.noalias() = input * weights.values;
+            return;
+        }
+        const int nRows = static_cast<int>(weights.valuesInt8.rows());
+        const int nCols = static_cast<int>(weights.valuesInt8.cols());
+        const int blockSize = nDequantized / nRows;
+        for (auto column = 0; column < nCols; column += blockSize)
+        {
+            const int n = std::min(blockSize, nCols - column);
+            Eigen::Map<Eigen::MatrixXf> block(dequantized.data(), nRows, n);
+            block = weights.valuesInt8.middleCols(column, n).cast<float>();
+            block.array().rowwise() *= weights.scales.segment(column, n).transpose().array();
+            output.middleCols(column, n).noalias() = input * block;
+        }
+    }
+
+    // layer normalization of each row
+    void layerNorm(Eigen::Ref<Eigen::MatrixXf> x, const Eigen::RowVectorXf &weight, const Eigen::RowVectorXf &bias)
+    {
+        constexpr float epsilon = 1e-5f;
+        const int nRows = static_cast<int>(x.rows());
+        rowMean.head(nRows) = x.rowwise().mean();
+        x.colwise() -= rowMean.head(nRows);
+        rowScale.head(nRows) = (x.array().square().rowwise().mean() + epsilon).rsqrt();
+        x.array().colwise() *= rowScale.head(nRows).array();
+        x.array().rowwise() *= weight.array();
+        x.rowwise() += bias;
+    }
+
+    // PReLU with a slope for each row
+    static void prelu(Eigen::Ref<Eigen::MatrixXf> x, const Eigen::VectorXf &slope)
+    {
+        x.array() = x.array().max(0.f) + x.array().min(0.f).colwise() * slope.array();
+    }
+
+    size_t getDynamicSizeVariables() const final
+    {
+        size_t size = magnitude.getDynamicMemorySize();
+        size += phase.getDynamicMemorySize();
+        size += gain.getDynamicMemorySize();
+        for (auto channel = 0; channel < C.nChannels; channel++)
+        {
+            size += gru1States[channel].getDynamicMemorySize();
+            size += gru2States[channel].getDynamicMemorySize();
+        }
+        size += encoderInput.getDynamicMemorySize();
+        size += denseNetInput.getDynamicMemorySize();
+        size += denseNetOutput.getDynamicMemorySize();
+        size += features.getDynamicMemorySize();
+        size += featuresTemp.getDynamicMemorySize();
+        size += projection.getDynamicMemorySize();
+        size += gatesInput.getDynamicMemorySize();
+        size += gatesState.getDynamicMemorySize();
+        size += gruOutput.getDynamicMemorySize();
+        size += rowMean.getDynamicMemorySize();
+        size += rowScale.getDynamicMemorySize();
+        size += dequantized.getDynamicMemorySize();
+        return size;
+    }
+
+    void resetVariables() final
+    {
+        magnitude.setZero();
+        phase.setZero();
+        for (auto channel = 0; channel < C.nChannels; channel++)
+        {
+            gru1States[channel].setZero();
+            gru2States[channel].setZero();
+        }
+        gain.setZero();
+        frameIndex = 0;
+    }
+
+    bool isCoefficientsValid() const final
+    {
+        bool flag = (C.algorithmType == C.ML_NATIVE) || (C.algorithmType == C.ML_NATIVE_INT8);
+        flag &= C.nBands == 257;
+        flag &= C.nChannels >= 1;
+        flag &= C.inferenceMode == C.SYNCHRONOUS; // ASYNCHRONOUS is implemented by NoiseReductionMLAsync
+        return flag;
+    }
+
+    // return weights for the model name, or read them if they are not in use by any other instance
+    static std::shared_ptr<const Weights> getWeights(const std::string &modelName)
+    {
+        // weights are stored as weak pointers, so they are released when no instance uses them
+        static std::mutex mutex;
+        static std::map<std::string, std::weak_ptr<const Weights>> cache;
+
+        std::lock_guard<std::mutex> lock(mutex);
+        std::weak_ptr<const Weights> &weightsCached = cache[modelName];
+        std::shared_ptr<const Weights> weightsShared = weightsCached.lock();
+        if (!weightsShared)
+        {
+            weightsShared = readWeights(modelName);
+            weightsCached = weightsShared;
+        }
+        return weightsShared;
+    }
+
+    static std::shared_ptr<const Weights> readWeights(const std::string &modelName)
+    {
+        const std::vector<char> model = ONNXModel::readModel(modelName);
+        const auto initializers = ONNXInitializerReader::read(model.data(), model.size());
+        const auto get = [&](const std::string &name, const std::vector<int64_t> &dims) -> const Eigen::ArrayXf & {
+            const auto it = initializers.find(name);
+            if ((it == initializers.end()) || (it->second.dataType != ONNXInitializer::FLOAT) || (it->second.dims != dims))
+            {
+                throw std::runtime_error("pp2model has a wrong or missing initializer: " + name);
+            }
+            return it->second.data;
+        };
+        const auto getColumn = [&](const std::string &name, const std::vector<int64_t> &dims) -> Eigen::VectorXf { return get(name, dims).matrix(); };
+        const auto getRow = [&](const std::string &name, const std::vector<int64_t> &dims) -> Eigen::RowVectorXf { return get(name, dims).matrix().transpose(); };
+
+        // return (rows x cols) matrix where element (row, col) is at offset + row * rowStride + col * colStride in the tensor. Int8 weights are stored by
+        // libs/onnx/quantize_model.py as "<name>_quantized" and "<name>_scale" with a scale for each output channel, which is a row if scalePerRow is true
+        const auto getWeightMatrix = [&](const std::string &name, const std::vector<int64_t> &dims, int offset, int rows, int cols, int rowStride, int colStride,
+                                         bool scalePerRow) {
+            using Stride = Eigen::Stride<Eigen::Dynamic, Eigen::Dynamic>;
+            WeightMatrix matrix;
+            const auto it = initializers.find(name + "_quantized");
+            if (it == initializers.end())
+            {
+                matrix.values = Eigen::Map<const Eigen::MatrixXf, 0, Stride>(get(name, dims).data() + offset, rows, cols, Stride(colStride, rowStride));
+                return matrix;
+            }
+            if ((it->second.dataType != ONNXInitializer::INT8) || (it->second.dims != dims)) { throw std::runtime_error("pp2model has a wrong initializer: " + it->first); }
+            using MatrixInt8 = Eigen::Matrix<int8_t, Eigen::Dynamic, Eigen::Dynamic>;
+            matrix.valuesInt8 = Eigen::Map<const MatrixInt8, 0, Stride>(it->second.dataInt8.data() + offset, rows, cols, Stride(colStride, rowStride));
+            matrix.scales = getColumn(name + "_scale", {scalePerRow ? rows : cols});
+            return matrix;
+        };
+
+        // convolution weights are (nOutputs x nInputs x kernelSize), so each kernel tap is a strided matrix
+        const auto getConvLayer = [&](const std::string &name, const std::string &slopeName, int nOutputs, int nInputs, int kernelSize, int dilation) {
+            ConvLayer layer;
+            for (auto tap = 0; tap < kernelSize; tap++)
+            {
+                layer.kernel.push_back(
+                    getWeightMatrix(name + ".conv.weight", {nOutputs, nInputs, kernelSize}, tap, nOutputs, nInputs, nInputs * kernelSize, kernelSize, true));
+            }
+            layer.bias = getColumn(name + ".conv.bias", {nOutputs});
+            layer.normWeight = getRow(name + ".instance_norm.weight", {257});
+            layer.normBias = getRow(name + ".instance_norm.bias", {257});
+            layer.slope = getColumn(slopeName, {nOutputs, 1});
+            layer.dilation = dilation;
+            return layer;
+        };
+        const auto getDenseNet = [&](const std::string &name, int firstSlope) {
+            std::array<ConvLayer, 5> layers;
+            for (auto i = 0; i < 4; i++)
+            {
+                layers[i] = getConvLayer(name + ".dilated_dense_blocks." + std::to_string(i), "onnx::PRelu_" + std::to_string(firstSlope + i), nFeatures, nFeatures, 3,
+                                         1 << i);
+            }
+            layers[4] = getConvLayer(name + ".final_layer", "onnx::PRelu_" + std::to_string(firstSlope + 4), nFeatures, 2 * nFeatures, 3, 1);
+            return layers;
+        };
+        const auto getGRULayer = [&](int firstWeight, const std::string &normName, const std::string &slopeName) {
+            GRULayer layer;
+            // ONNX weights are (3 * nHidden x nInputs), so they are transposed
+            layer.inputWeights = getWeightMatrix("onnx::GRU_" + std::to_string(firstWeight), {1, 3 * nHidden, nHidden}, 0, nHidden, 3 * nHidden, 1, nHidden, false);
+            layer.stateWeights = getWeightMatrix("onnx::GRU_" + std::to_string(firstWeight + 1), {1, 3 * nHidden, nHidden}, 0, nHidden, 3 * nHidden, 1, nHidden, false);
+            const Eigen::RowVectorXf bias = getRow("onnx::GRU_" + std::to_string(firstWeight + 2), {1, 6 * nHidden});
+            layer.inputBias = bias.head(3 * nHidden);
+            layer.stateBias = bias.tail(3 * nHidden);
+            layer.normWeight = getRow(normName + ".weight", {nHidden});
+            layer.normBias = getRow(normName + ".bias", {nHidden});
+            layer.slope = getColumn(slopeName, {nBatch, 1});
+            return layer;
+        };
+
+        // names of the PReLU, MatMul and GRU weights are given by the exporter
+        auto w = std::make_shared<Weights>();
+        w->magnitudeEncoder = getConvLayer("mag_encode", "onnx::PRelu_566", nEncoded, nFrames, 1, 1);
+        w->phaseEncoder = getConvLayer("phase_encode", "onnx::PRelu_567", nEncoded, nFrames, 1, 1);
+        w->expander = getConvLayer("dense_expander", "onnx::PRelu_568", nFeatures, 2 * nEncoded, 1, 1);
+        w->denseNet1 = getDenseNet("dilated_dense_net", 569);
+        w->projectionWeights = getWeightMatrix("onnx::MatMul_574", {257, nBatch}, 0, 257, nBatch, nBatch, 1, false);
+        w->projectionBias = getRow("gru_time_freq.linear.bias", {nBatch});
+        w->projectionNormWeight = getRow("gru_time_freq.norm0.weight", {nBatch});
+        w->projectionNormBias = getRow("gru_time_freq.norm0.bias", {nBatch});
+        w->projectionSlope = getColumn("onnx::PRelu_575", {nFeatures, 1});
+        w->gru1 = getGRULayer(593, "gru_time_freq.norm1_time", "onnx::PRelu_596");
+        w->gru2 = getGRULayer(614, "gru_time_freq.norm2_time", "onnx::PRelu_617");
+        w->expansionWeights = getWeightMatrix("onnx::MatMul_618", {nBatch, 257}, 0, nBatch, 257, 257, 1, false);
+        w->expansionBias = getRow("dense3.bias", {257});
+        w->expansionSlope = getColumn("onnx::PRelu_619", {nFeatures, 1});
+        w->expansionNormWeight = getRow("norm3.weight", {257});
+        w->expansionNormBias = getRow("norm3.bias", {257});
+        w->residualSlope = getColumn("onnx::PRelu_620", {nFeatures, 1});
+        w->residualNormWeight = getRow("norm5.weight", {257});
+        w->residualNormBias = getRow("norm5.bias", {257});
+        w->denseConv = getConvLayer("dense_conv", "onnx::PRelu_621", nFeatures, nFeatures, 1, 1);
+        w->denseNet2 = getDenseNet("dilated_dense_net2", 622);
+        w->contractorSlope = getColumn("onnx::PRelu_627", {nFeatures, 1});
+        w->contractorNormWeight = getRow("dense_contractor.instance_norm.weight", {257});
+        w->contractorNormBias = getRow("dense_contractor.instance_norm.bias", {257});
+        w->contractorWeights = getWeightMatrix("dense_contractor.conv.weight", {1, nFeatures, 1}, 0, nFeatures, 1, 1, nFeatures, false);
+        w->contractorBias = get("dense_contractor.conv.bias", {1})(0);
+        return w;
+    }
+
+    friend BaseAlgorithm;
+};
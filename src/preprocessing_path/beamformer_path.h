@@ -22,7 +22,8 @@ class BeamformerPath : public AlgorithmImplementation<PreprocessingPathConfigura
           dcRemover({.nChannels = c.nChannels, .sampleRate = c.sampleRate})
     {
         xTime.resize(C.bufferSize, C.nChannels);
-        xFreq.resize(nBands, C.nChannels);
+        xFreq.resize(FFTConfiguration::convertFFTSizeToNBandsPadded(4 * c.bufferSize), C.nChannels); // padded so the FFT writes directly to all channels
+        xFreq.setZero();
         xFreq2.resize(nBands, C.nChannels);
         xBeamformed.resize(nBands);
         xBeamformedNoise.resize(nBands);
@@ -51,15 +52,16 @@ class BeamformerPath : public AlgorithmImplementation<PreprocessingPathConfigura
     void processAlgorithm(Input input, Output output)
     {
         dcRemover.process(input, xTime);
-        filterbank.process(xTime, xFreq);
-        xFreq2 = xFreq.abs2();
+        auto xFreqBands = xFreq.topRows(nBands);
+        filterbank.process(xTime, xFreqBands);
+        xFreq2 = xFreqBands.abs2();
         activityDetector.process(xFreq2, activity);
-        beamformer.process({xFreq, activity}, {xBeamformed, xBeamformedNoise});
+        beamformer.process({xFreqBands, activity}, {xBeamformed, xBeamformedNoise});
         filterbankInverse.process(xBeamformed, output);
     }
 
     Eigen::ArrayXXf xTime;
-    Eigen::ArrayXXcf xFreq;
+    Eigen::ArrayXXcf xFreq; // nBands rows padded to an even number, so all channels are 16 byte aligned
     Eigen::ArrayXXf xFreq2;
     Eigen::ArrayXcf xBeamformed;
     Eigen::ArrayXcf xBeamformedNoise;
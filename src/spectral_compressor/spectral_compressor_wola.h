@@ -1,8 +1,9 @@
 #pragma once
 #include "algorithm_library/spectral_compressor.h"
-#include "filterbank/filterbank_wola.h"
+#include "filterbank/filterbank_processor.h"
 #include "framework/framework.h"
 #include "utilities/fastonebigheader.h"
+#include "utilities/vector_math.h"
 
 // Spectral compressor using a weighted overlap-add (WOLA) filter bank.
 //
@@ -10,8 +11,7 @@
 class SpectralCompressorWOLA : public AlgorithmImplementation<SpectralCompressorConfiguration, SpectralCompressorWOLA>
 {
   public:
-    SpectralCompressorWOLA(Coefficients c = Coefficients())
-        : BaseAlgorithm{c}, filterbank(convertToFilterbankCoefficients(c)), filterbankInverse(convertToFilterbankInverseCoefficients(c))
+    SpectralCompressorWOLA(Coefficients c = Coefficients()) : BaseAlgorithm{c}, filterbank(convertToFilterbankCoefficients(c))
     {
         Eigen::ArrayXf window = FilterbankShared::getAnalysisWindow(convertToFilterbankCoefficients(c));
         sumWindow = lin2dB(window.sum() / 2.f);                      // scaled so sine wave with amplitude 1 gives threshold level
@@ -19,7 +19,6 @@ class SpectralCompressorWOLA : public AlgorithmImplementation<SpectralCompressor
 
         nBands = FFTReal::Configuration::convertFFTSizeToNBands(c.bufferSize * 4);
 
-        filterbankOut.resize(nBands, c.nChannels);
         energy.resize(nBands);
         gain.resize(nBands, c.nChannels);
 
@@ -27,30 +26,24 @@ class SpectralCompressorWOLA : public AlgorithmImplementation<SpectralCompressor
         onParametersChanged();
     }
 
-    FilterbankAnalysisWOLA filterbank;
-    FilterbankSynthesisWOLA filterbankInverse;
+    FilterbankProcessor filterbank;
 
-    DEFINE_MEMBER_ALGORITHMS(filterbank, filterbankInverse)
+    DEFINE_MEMBER_ALGORITHMS(filterbank)
 
     float getDelaySamples() const { return static_cast<float>(C.bufferSize * 3); }
 
   private:
     void inline processAlgorithm(Input input, Output output)
     {
-        filterbank.process(input, filterbankOut);
-        for (auto channel = 0; channel < C.nChannels; channel++)
-        {
-            energy = filterbankOut.col(channel).abs2();
-            for (auto band = 0; band < nBands; band++)
-            {
-                float energydB = energy2dB(energy(band) + 1e-20f); // 10*log10(x)
-                float gainBanddB = energydB > threshold ? ratioOffset - ratioScale * energydB : 0.f;
-                float gainBand = dB2lin(gainBanddB); // 10^(x/20)
-                gain(band, channel) += gainBand > gain(band, channel) ? gainUpLambda * (gainBand - gain(band, channel)) : gainDownLambda * (gainBand - gain(band, channel));
-            }
-        }
-        filterbankOut *= gain;
-        filterbankInverse.process(filterbankOut, output);
+        filterbank.process(input, output, [this](Eigen::ArrayXcf &xFreq, int channel) {
+            // energy is converted in place to dB, gain in dB and linear gain
+            energy = xFreq.abs2() + 1e-20f;
+            VectorMath::energy2dB(energy, energy); // 10*log10(x)
+            energy = (energy > threshold).select(ratioOffset - ratioScale * energy, 0.f);
+            VectorMath::dB2lin(energy, energy); // 10^(x/20)
+            gain.col(channel) += (energy > gain.col(channel)).select(gainUpLambda * (energy - gain.col(channel)), gainDownLambda * (energy - gain.col(channel)));
+            xFreq *= gain.col(channel);
+        });
     }
 
     void onParametersChanged()
@@ -66,32 +59,20 @@ class SpectralCompressorWOLA : public AlgorithmImplementation<SpectralCompressor
 
     size_t getDynamicSizeVariables() const final
     {
-        size_t size = filterbankOut.getDynamicMemorySize();
-        size += energy.getDynamicMemorySize();
+        size_t size = energy.getDynamicMemorySize();
         size += gain.getDynamicMemorySize();
         return size;
     }
 
     void resetVariables() final
     {
-        filterbankOut.setZero();
         energy.setZero();
         gain.setOnes();
     }
 
-    FilterbankAnalysisWOLA::Coefficients convertToFilterbankCoefficients(const Coefficients &c)
+    FilterbankProcessor::Coefficients convertToFilterbankCoefficients(const Coefficients &c)
     {
-        FilterbankAnalysisWOLA::Coefficients cFilterbank;
-        cFilterbank.bufferSize = c.bufferSize;
-        cFilterbank.nChannels = c.nChannels;
-        cFilterbank.nBands = FFTReal::Configuration::convertFFTSizeToNBands(c.bufferSize * 4);
-        cFilterbank.filterbankType = cFilterbank.HANN;
-        return cFilterbank;
-    }
-
-    FilterbankSynthesisWOLA::Coefficients convertToFilterbankInverseCoefficients(const Coefficients &c)
-    {
-        FilterbankSynthesisWOLA::Coefficients cFilterbank;
+        FilterbankProcessor::Coefficients cFilterbank;
         cFilterbank.bufferSize = c.bufferSize;
         cFilterbank.nChannels = c.nChannels;
         cFilterbank.nBands = FFTReal::Configuration::convertFFTSizeToNBands(c.bufferSize * 4);
@@ -107,7 +88,6 @@ class SpectralCompressorWOLA : public AlgorithmImplementation<SpectralCompressor
     float ratioOffset;
     float gainUpLambda;
     float gainDownLambda;
-    Eigen::ArrayXXcf filterbankOut;
     Eigen::ArrayXf energy;
     Eigen::ArrayXXf gain;
 
@@ -1,16 +1,89 @@
 #include "spectrogram/spectrogram_filterbank.h"
+#include "spectrogram/spectrogram_nonlinear_kernel.h"
 #include "spectrogram/spectrogram_set.h"
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 using FilterbankImpl = Implementation<SpectrogramFilterbank, SpectrogramConfiguration>;
 using NonlinearImpl = Implementation<SpectrogramSet, SpectrogramConfiguration>;
+using NonlinearKernelImpl = Implementation<SpectrogramNonlinearKernel, SpectrogramConfiguration>;
 
 template <>
 void Algorithm<SpectrogramConfiguration>::setImplementation(const Coefficients &c)
 {
     if ((c.algorithmType == c.ADAPTIVE_HANN_8) || (c.algorithmType == c.ADAPTIVE_WOLA_8)) { pimpl = std::make_unique<NonlinearImpl>(c); }
+    else if (c.algorithmType == c.ADAPTIVE_HANN_8_KERNEL) { pimpl = std::make_unique<NonlinearKernelImpl>(c); }
     else { pimpl = std::make_unique<FilterbankImpl>(c); }
 }
 
 Spectrogram::Spectrogram(const Coefficients &c) : Algorithm<SpectrogramConfiguration>(c) {}
 
-int SpectrogramConfiguration::getValidFFTSize(int fftSize) { return FFTConfiguration::getValidFFTSize(fftSize); }
\ No newline at end of file
+int SpectrogramConfiguration::getValidFFTSize(int fftSize) { return FFTConfiguration::getValidFFTSize(fftSize); }
+
+void Spectrogram::processFrames(I::Real input, O::Real2D output, int nThreads) const
+{
+    processFrames([&input](int startSample, O::Real samples) { samples = input.segment(startSample, samples.size()); }, static_cast<int>(input.size()), output, nThreads);
+}
+
+void Spectrogram::processFrames(const SampleReader &readSamples, int nSamples, O::Real2D output, int nThreads) const
+{
+    const Coefficients c = getCoefficients();
+    const int nFramesPerBuffer = SpectrogramConfiguration::getNFramesPerBuffer(c);
+    const int nBuffers = nSamples / c.bufferSize;
+    if ((output.rows() != c.nBands) || (output.cols() != nBuffers * nFramesPerBuffer)) { throw SpectrogramConfiguration::ExceptionSpectrogramFrames(nSamples, c); }
+    if (nBuffers == 0) { return; }
+
+    // The longest memory is in SpectrogramSet with ADAPTIVE_WOLA_8, where the analysis window is 2*fftSize and the output is upsampled from the previous buffer.
+    // Priming each chunk with this many buffers makes it independent of what came before
+    const int fftSize = FFTConfiguration::convertNBandsToFFTSize(c.nBands);
+    const int nBuffersWarmup = (2 * fftSize + c.bufferSize - 1) / c.bufferSize + 1;
+
+    if (nThreads <= 0) { nThreads = std::max(static_cast<int>(std::thread::hardware_concurrency()), 1); }
+    nThreads = std::min(nThreads, nBuffers);
+    const int nBuffersPerThread = (nBuffers + nThreads - 1) / nThreads;
+
+    auto processBuffers = [&](int bufferStart, int bufferEnd) {
+        Spectrogram spectrogram(c);
+        Eigen::ArrayXf samples(c.bufferSize);
+        Eigen::ArrayXXf outputWarmup(c.nBands, nFramesPerBuffer);
+        for (auto buffer = std::max(bufferStart - nBuffersWarmup, 0); buffer < bufferStart; buffer++)
+        {
+            readSamples(buffer * c.bufferSize, samples);
+            spectrogram.process(samples, outputWarmup);
+        }
+        for (auto buffer = bufferStart; buffer < bufferEnd; buffer++)
+        {
+            readSamples(buffer * c.bufferSize, samples);
+            spectrogram.process(samples, output.middleCols(buffer * nFramesPerBuffer, nFramesPerBuffer));
+        }
+    };
+
+    std::exception_ptr exception; // first exception thrown by readSamples in any of the threads
+    std::mutex exceptionMutex;
+    auto processChunk = [&](int bufferStart, int bufferEnd) {
+        try
+        {
+            processBuffers(bufferStart, bufferEnd);
+        }
+        catch (...)
+        {
+            std::lock_guard<std::mutex> lock(exceptionMutex);
+            if (!exception) { exception = std::current_exception(); }
+        }
+    };
+
+    // each thread writes to its own columns of the output
+    std::vector<std::thread> threads;
+    for (auto bufferStart = nBuffersPerThread; bufferStart < nBuffers; bufferStart += nBuffersPerThread)
+    {
+        threads.emplace_back(processChunk, bufferStart, std::min(bufferStart + nBuffersPerThread, nBuffers));
+    }
+    processChunk(0, std::min(nBuffersPerThread, nBuffers)); // first chunk is processed on the calling thread
+    for (auto &thread : threads)
+    {
+        thread.join();
+    }
+    if (exception) { std::rethrow_exception(exception); }
+}
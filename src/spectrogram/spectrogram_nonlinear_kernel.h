@@ -0,0 +1,173 @@
+#pragma once
+#include "algorithm_library/spectrogram.h"
+#include "fft/fft_real.h"
+#include "framework/framework.h"
+#include "utilities/fastonebigheader.h"
+#include "utilities/functions.h"
+
+// Spectrogram implemented as a nonlinear combination of several standard spectrograms that are all calculated from a single FFT. The criteria used for selecting
+// the best time/frequency bin is the minimum power.
+//
+// The windows are the same as in SpectrogramNonlinear (not SpectrogramSet, which Spectrogram uses for ADAPTIVE_HANN_8): a Hann window of length fftSize and Hann
+// windows of length fftSize/2, fftSize/4 and fftSize/8 centered in the frame. For each of the 8 sub-frames only the frame with the full-length Hann window is
+// transformed. The shorter windows equal the full-length window multiplied by a window ratio, so their spectra are calculated by convolving the spectrum with the
+// spectrum of the window ratio. These kernels are real and truncated to kernelLobes times the main lobe of the shorter window, so the spectra of the shorter
+// windows are approximations. Compared to SpectrogramNonlinear, bins within 20 dB of the maximum of their frame are within 3 dB, while weaker bins are dominated
+// by leakage from the truncated kernels and can be off by more than 10 dB (see unit test). Longer kernels reduce the error, but are slower than
+// SpectrogramNonlinear.
+//
+// The kernels are applied to blocks of bins that are kept in registers, so the speed depends on the SIMD width the library is compiled with. The FFT is calculated
+// with SSE in pffft, while the kernels are vectorized by Eigen. Compared to SpectrogramNonlinear it is roughly as fast with SSE and 1.5x faster with AVX2.
+//
+// author: Kristian Timm Andersen
+class SpectrogramNonlinearKernel : public AlgorithmImplementation<SpectrogramConfiguration, SpectrogramNonlinearKernel>
+{
+  public:
+    SpectrogramNonlinearKernel(Coefficients c = {.bufferSize = 1024, .nBands = 1025, .algorithmType = Coefficients::ADAPTIVE_HANN_8_KERNEL})
+        : BaseAlgorithm{c}, fft({FFTConfiguration::convertNBandsToFFTSize(c.nBands)})
+    {
+        assert(c.algorithmType == Coefficients::ADAPTIVE_HANN_8_KERNEL);
+
+        fftSize = FFTConfiguration::convertNBandsToFFTSize(c.nBands);
+        bufferSizeSmall = c.bufferSize / nOutputFrames; // algorithm is hardcoded to process in buffersize of this size
+
+        // set windows the same way as SpectrogramNonlinear. The shorter windows are calculated as the full-length Hann window multiplied by a window ratio, and the
+        // kernels are the spectra of the window ratios. The windows are symmetric around fftSize/2, so the spectra are real
+        window = hann(fftSize);
+        const float sqrtPower = std::sqrt(window.abs2().sum());
+        Eigen::ArrayXf windowSmall(fftSize);
+        Eigen::ArrayXcf windowSpectrum(c.nBands);
+        kernels = Eigen::ArrayXXf::Zero(kernelSizeMax + 1, nWindows - 1);
+        for (auto i = 1; i < nWindows; i++)
+        {
+            const int frameSizeSmall = FFTConfiguration::getValidFFTSize(fftSize / positivePow2(i));
+            windowSmall.setZero();
+            windowSmall.segment((fftSize - frameSizeSmall) / 2, frameSizeSmall) =
+                Eigen::ArrayXf::Map(window.data(), frameSizeSmall, Eigen::InnerStride<>(fftSize / frameSizeSmall));
+            windowSmall *= sqrtPower / std::sqrt(windowSmall.abs2().sum());
+            windowSmall = (windowSmall > 0.f).select(windowSmall / window, 0.f); // window ratio
+            fft.process(windowSmall, windowSpectrum);
+            const int kernelSize = std::min(getKernelSize(i), c.nBands - 1); // kernels can't be longer than the spectrum for small FFT sizes
+            kernels.col(i - 1).head(kernelSize + 1) = windowSpectrum.head(kernelSize + 1).real() / fftSize;
+            if (kernelSize == c.nBands - 1) { kernels(kernelSize, i - 1) *= .5f; } // Nyquist bin is reached from both sides
+        }
+
+        timeBuffer.resize(fftSize);
+        fftBuffer.resize(fftSize);
+        const int nBandsPadded = (c.nBands + blockSize - 1) / blockSize * blockSize;
+        spectrumExtended.resize(nBandsPadded + 2 * kernelSizeMax);
+        spectrumWindowed.resize(nBandsPadded, nWindows - 1);
+
+        resetVariables();
+    }
+
+    FFTReal fft;
+    DEFINE_MEMBER_ALGORITHMS(fft)
+
+  private:
+    void inline processAlgorithm(Input input, Output output)
+    {
+        const int nBands = C.nBands;
+        for (auto frame = 0; frame < nOutputFrames; frame++)
+        {
+            timeBuffer.segment(index, bufferSizeSmall) = input.segment(frame * bufferSizeSmall, bufferSizeSmall); // overwrite oldest block
+            index = (index + bufferSizeSmall) % fftSize;
+            fftBuffer.head(fftSize - index) = timeBuffer.tail(fftSize - index) * window.head(fftSize - index);
+            fftBuffer.tail(index) = timeBuffer.head(index) * window.tail(index);
+            fft.process(fftBuffer, spectrumExtended.segment(kernelSizeMax, nBands));
+
+            // extend spectrum below DC and above Nyquist, so the kernels can be applied without boundary checks
+            for (auto bin = -kernelSizeMax; bin < 0; bin++)
+            {
+                spectrumExtended(kernelSizeMax + bin) = getExtendedBin(bin);
+            }
+            for (auto bin = nBands; bin < static_cast<int>(spectrumExtended.size()) - kernelSizeMax; bin++)
+            {
+                spectrumExtended(kernelSizeMax + bin) = getExtendedBin(bin);
+            }
+
+            // the kernels are real, so they are applied to the interleaved real and imaginary parts. The bins are processed in small blocks, so the windowed spectra
+            // stay in registers, and the sum of the two bins at distance m from the center bin is shared by all windows with a kernel of at least that size
+            const float *spectrumCenter = reinterpret_cast<const float *>(spectrumExtended.data() + kernelSizeMax);
+            for (auto bin = 0; bin < nBands; bin += blockSize)
+            {
+                const float *x = spectrumCenter + 2 * bin;
+                const Block center = Eigen::Map<const Block>(x);
+                Block block1 = kernels(0, 0) * center;
+                Block block2 = kernels(0, 1) * center;
+                Block block3 = kernels(0, 2) * center;
+                for (auto m = 1; m <= getKernelSize(1); m++)
+                {
+                    const Block sum = Eigen::Map<const Block>(x - 2 * m) + Eigen::Map<const Block>(x + 2 * m);
+                    block1 += kernels(m, 0) * sum;
+                    block2 += kernels(m, 1) * sum;
+                    block3 += kernels(m, 2) * sum;
+                }
+                for (auto m = getKernelSize(1) + 1; m <= getKernelSize(2); m++)
+                {
+                    const Block sum = Eigen::Map<const Block>(x - 2 * m) + Eigen::Map<const Block>(x + 2 * m);
+                    block2 += kernels(m, 1) * sum;
+                    block3 += kernels(m, 2) * sum;
+                }
+                for (auto m = getKernelSize(2) + 1; m <= getKernelSize(3); m++)
+                {
+                    block3 += kernels(m, 2) * (Eigen::Map<const Block>(x - 2 * m) + Eigen::Map<const Block>(x + 2 * m));
+                }
+                Eigen::Map<Block>(reinterpret_cast<float *>(&spectrumWindowed(bin, 0))) = block1;
+                Eigen::Map<Block>(reinterpret_cast<float *>(&spectrumWindowed(bin, 1))) = block2;
+                Eigen::Map<Block>(reinterpret_cast<float *>(&spectrumWindowed(bin, 2))) = block3;
+            }
+            output.col(frame) = spectrumExtended.segment(kernelSizeMax, nBands).abs2().min(spectrumWindowed.col(0).head(nBands).abs2());
+            output.col(frame) = output.col(frame).min(spectrumWindowed.col(1).head(nBands).abs2()).min(spectrumWindowed.col(2).head(nBands).abs2());
+        }
+    }
+
+    // kernel half length of window i > 0. The main lobe of a Hann window of length fftSize / 2^i is 2^(i+1) bins on each side
+    static constexpr int getKernelSize(int i) { return kernelLobes * positivePow2(i + 1); }
+
+    // return any bin of the spectrum using that the spectrum of a real signal is periodic and conjugate symmetric
+    std::complex<float> getExtendedBin(int bin) const
+    {
+        const int binWrapped = (bin % fftSize + fftSize) % fftSize;
+        if (binWrapped < C.nBands) { return spectrumExtended(kernelSizeMax + binWrapped); }
+        return std::conj(spectrumExtended(kernelSizeMax + fftSize - binWrapped));
+    }
+
+    // the sub-frames must tile the FFT frame, since timeBuffer is a circular buffer of fftSize samples that is written bufferSizeSmall samples at a time
+    bool isCoefficientsValid() const final
+    {
+        return (C.bufferSize > 0) && (C.bufferSize % nOutputFrames == 0) && (fftSize % bufferSizeSmall == 0);
+    }
+
+    size_t getDynamicSizeVariables() const final
+    {
+        size_t size = window.getDynamicMemorySize();
+        size += kernels.getDynamicMemorySize();
+        size += timeBuffer.getDynamicMemorySize();
+        size += fftBuffer.getDynamicMemorySize();
+        size += spectrumExtended.getDynamicMemorySize();
+        size += spectrumWindowed.getDynamicMemorySize();
+        return size;
+    }
+
+    void resetVariables() final
+    {
+        timeBuffer.setZero();
+        index = 0;
+    }
+
+    static constexpr int nWindows = 4;                                         // 4 windows that each halves the window length
+    static constexpr int nOutputFrames = positivePow2(nWindows - 1);           // 8 output frames
+    static constexpr int kernelLobes = 1;                                      // kernels of the shorter windows are truncated to this many main lobe widths
+    static constexpr int blockSize = 4;                                        // number of bins in each block when applying the kernels
+    static constexpr int kernelSizeMax = kernelLobes * positivePow2(nWindows); // even, so the FFT output in spectrumExtended is 16 byte aligned
+    using Block = Eigen::Array<float, 2 * blockSize, 1>;                       // interleaved real and imaginary parts of a block
+    int fftSize, bufferSizeSmall;
+    int index; // start of the oldest block in the circular timeBuffer
+    Eigen::ArrayXXf kernels; // one-sided kernels, where kernels(m, i - 1) is the weight of bins at distance m for window i
+    Eigen::ArrayXf window, timeBuffer, fftBuffer;
+    Eigen::ArrayXcf spectrumExtended;
+    Eigen::ArrayXXcf spectrumWindowed;
+
+    friend BaseAlgorithm;
+};
@@ -0,0 +1,154 @@
+#pragma once
+#include "framework/framework.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Run a model that calculates a gain from a complex spectrum on a worker thread. process() is called from the audio thread, where it submits the input to the worker
+// and applies the gain of the previous frame to the previous input, so the output is delayed by 1 frame. The model has to be an algorithm with the method
+// getGain() that returns the gain from its last call to process.
+//
+// The inputs are passed to the worker in a single-producer single-consumer queue of nFramesQueue preallocated frames. The audio thread and the worker each
+// increment a frame counter, and the frames between the two counters are owned by the worker. If the worker has not finished all submitted frames when process()
+// is called, the deadline is missed and the previous gain is held, but the current input is still queued, so a recurrent model sees every frame in order and its
+// state is the same as if it was run synchronously. Only if the queue is full is the input dropped and never seen by the model (see getDroppedFrames). After a
+// stall the worker processes the queued frames back to back, and the gain is updated again when it has caught up with the audio thread.
+//
+// process() doesn't allocate memory. It locks the mutex to notify the worker, which is only held by the worker while it checks for new frames, so the lock is
+// uncontended except for that short window. The worker blocks on the condition variable until a frame is submitted, so it doesn't wake up when idle.
+//
+// The object must not be moved while the worker is running, so it is allocated on the heap by its owner.
+//
+// author: Kristian Timm Andersen
+template <typename Tmodel>
+class AsyncInference
+{
+  public:
+    AsyncInference(const typename Tmodel::Coefficients &c) : model(c)
+    {
+        xFreqQueue.resize(nFramesQueue);
+        for (auto &xFreqQueued : xFreqQueue)
+        {
+            xFreqQueued = Eigen::ArrayXXcf::Zero(c.nBands, c.nChannels);
+        }
+        xFreqPrevious = Eigen::ArrayXXcf::Zero(c.nBands, c.nChannels);
+        yFreqModel = Eigen::ArrayXXcf::Zero(c.nBands, c.nChannels);
+        gainModel = Eigen::ArrayXXf::Zero(c.nBands, c.nChannels);
+        gainApplied = Eigen::ArrayXXf::Zero(c.nBands, c.nChannels);
+        worker = std::thread(&AsyncInference::run, this);
+    }
+
+    ~AsyncInference()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stop = true;
+            condition.notify_one();
+        }
+        worker.join();
+    }
+
+    AsyncInference(const AsyncInference &) = delete;
+    AsyncInference &operator=(const AsyncInference &) = delete;
+
+    // called from the audio thread
+    void process(I::Complex2D xFreq, O::Complex2D yFreq)
+    {
+        const uint64_t nSubmitted = submitted.load(std::memory_order_relaxed);
+        const uint64_t nCompleted = completed.load(std::memory_order_acquire);
+        if (nCompleted == nSubmitted) { gainApplied = gainModel; }
+        else { deadlineMisses++; }
+
+        if (nSubmitted - nCompleted < nFramesQueue)
+        {
+            xFreqQueue[nSubmitted % nFramesQueue] = xFreq;
+            std::lock_guard<std::mutex> lock(mutex);
+            submitted.store(nSubmitted + 1, std::memory_order_release);
+            condition.notify_one();
+        }
+        else { droppedFrames++; }
+
+        yFreq = gainApplied * xFreqPrevious;
+        xFreqPrevious = xFreq;
+    }
+
+    // block until the worker has finished all submitted frames. This is not real-time safe, but it can be used to process offline without deadline misses
+    void waitForInference() const
+    {
+        while (completed.load(std::memory_order_acquire) != submitted.load(std::memory_order_relaxed))
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    void reset()
+    {
+        waitForInference();
+        model.reset();
+        xFreqPrevious.setZero();
+        gainModel.setZero();
+        gainApplied.setZero();
+        deadlineMisses = 0;
+        droppedFrames = 0;
+    }
+
+    // number of frames where the gain of the previous frame was not ready
+    int getDeadlineMisses() const { return deadlineMisses; }
+
+    // number of frames that were not processed by the model, because the queue was full
+    int getDroppedFrames() const { return droppedFrames; }
+
+    size_t getDynamicMemorySize() const
+    {
+        size_t size = model.getDynamicSize();
+        for (auto &xFreqQueued : xFreqQueue)
+        {
+            size += xFreqQueued.getDynamicMemorySize();
+        }
+        size += xFreqPrevious.getDynamicMemorySize();
+        size += yFreqModel.getDynamicMemorySize();
+        size += gainModel.getDynamicMemorySize();
+        size += gainApplied.getDynamicMemorySize();
+        return size;
+    }
+
+    static constexpr int nFramesQueue = 4; // max number of frames submitted to the worker, including the frame that is being processed
+
+  private:
+    void run()
+    {
+        uint64_t nCompleted = 0;
+        while (true)
+        {
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                condition.wait(lock, [&] { return stop || (submitted.load(std::memory_order_acquire) != nCompleted); });
+                if (stop) { return; }
+            }
+            model.process(xFreqQueue[nCompleted % nFramesQueue], yFreqModel);
+            gainModel = model.getGain();
+            nCompleted++;
+            completed.store(nCompleted, std::memory_order_release);
+        }
+    }
+
+    Tmodel model;
+    std::vector<Eigen::ArrayXXcf> xFreqQueue;       // circular queue of inputs, where the frames from completed to submitted are owned by the worker
+    Eigen::ArrayXXcf xFreqPrevious, yFreqModel;     // yFreqModel is owned by the worker
+    Eigen::ArrayXXf gainModel, gainApplied;         // gainModel is owned by the worker while frames are submitted
+    int deadlineMisses = 0;
+    int droppedFrames = 0;
+
+    std::atomic<uint64_t> submitted{0}; // written by the audio thread
+    std::atomic<uint64_t> completed{0}; // written by the worker
+    std::mutex mutex;
+    std::condition_variable condition;
+    bool stop = false; // protected by mutex
+    std::thread worker;
+};
+
+template <typename Tmodel>
+constexpr int AsyncInference<Tmodel>::nFramesQueue;
@@ -0,0 +1,192 @@
+#pragma once
+#include "framework/framework.h"
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// Read the float and int8 initializers (weights) of an ONNX model file without ONNX Runtime. The file is a protobuf serialized ModelProto, and only the fields
+// needed to find the initializers are parsed: ModelProto.graph (7) -> GraphProto.initializer (5) -> TensorProto with dims (1), data_type (2), float_data (4),
+// int32_data (5), name (8) and raw_data (9). All other fields are skipped. The data is in row-major order as in ONNX.
+//
+// author: Kristian Timm Andersen
+
+struct ONNXInitializer
+{
+    enum DataType { FLOAT = 1, INT8 = 3 }; // values of TensorProto.DataType
+    int dataType;
+    std::vector<int64_t> dims;
+    Eigen::ArrayXf data;                              // if dataType is FLOAT
+    Eigen::Array<int8_t, Eigen::Dynamic, 1> dataInt8; // if dataType is INT8
+};
+
+class ONNXInitializerReader
+{
+  public:
+    // return map from initializer name to initializer. Throws std::runtime_error if the file can not be read or parsed
+    static std::map<std::string, ONNXInitializer> read(const std::string &fileName)
+    {
+        std::ifstream file(fileName, std::ios::binary);
+        if (!file) { throw std::runtime_error("Could not open ONNX file: " + fileName); }
+        const std::vector<char> bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+        return read(bytes.data(), bytes.size());
+    }
+
+    // return map from initializer name to initializer of a model in memory. Throws std::runtime_error if the model can not be parsed
+    static std::map<std::string, ONNXInitializer> read(const char *data, size_t size)
+    {
+        const uint8_t *bytes = reinterpret_cast<const uint8_t *>(data);
+        std::map<std::string, ONNXInitializer> initializers;
+        Message model{bytes, bytes + size};
+        Field field;
+        while (model.next(field))
+        {
+            if ((field.number != 7) || (field.wireType != LENGTH_DELIMITED)) { continue; } // graph
+            Message graph{field.begin, field.end};
+            while (graph.next(field))
+            {
+                if ((field.number != 5) || (field.wireType != LENGTH_DELIMITED)) { continue; } // initializer
+                std::string name;
+                ONNXInitializer initializer;
+                if (readTensor({field.begin, field.end}, name, initializer)) { initializers[name] = std::move(initializer); }
+            }
+        }
+        return initializers;
+    }
+
+  private:
+    enum WireType { VARINT = 0, FIXED64 = 1, LENGTH_DELIMITED = 2, FIXED32 = 5 };
+
+    struct Field
+    {
+        int number;
+        int wireType;
+        uint64_t value;       // VARINT, FIXED32 and FIXED64
+        const uint8_t *begin; // LENGTH_DELIMITED
+        const uint8_t *end;
+    };
+
+    struct Message
+    {
+        const uint8_t *position;
+        const uint8_t *end;
+
+        uint64_t readVarint()
+        {
+            uint64_t value = 0;
+            for (auto shift = 0; shift < 64; shift += 7)
+            {
+                if (position >= end) { throw std::runtime_error("ONNX file is truncated"); }
+                const uint8_t byte = *position++;
+                value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+                if ((byte & 0x80) == 0) { return value; }
+            }
+            throw std::runtime_error("ONNX file has an invalid varint");
+        }
+
+        bool next(Field &field)
+        {
+            if (position >= end) { return false; }
+            const uint64_t key = readVarint();
+            field.number = static_cast<int>(key >> 3);
+            field.wireType = static_cast<int>(key & 7);
+            size_t size = 0;
+            switch (field.wireType)
+            {
+            case VARINT: field.value = readVarint(); return true;
+            case FIXED64: size = 8; break;
+            case FIXED32: size = 4; break;
+            case LENGTH_DELIMITED: size = static_cast<size_t>(readVarint()); break;
+            default: throw std::runtime_error("ONNX file has an unsupported wire type");
+            }
+            if (size > static_cast<size_t>(end - position)) { throw std::runtime_error("ONNX file is truncated"); }
+            field.begin = position;
+            field.end = position + size;
+            field.value = 0;
+            if (field.wireType != LENGTH_DELIMITED) { std::memcpy(&field.value, position, size); } // little endian
+            position += size;
+            return true;
+        }
+    };
+
+    // return false if the tensor is not a float or int8 tensor
+    static bool readTensor(Message tensor, std::string &name, ONNXInitializer &initializer)
+    {
+        initializer.dataType = ONNXInitializer::FLOAT;
+        std::vector<float> floatData;
+        std::vector<int32_t> int32Data;
+        const uint8_t *rawBegin = nullptr, *rawEnd = nullptr;
+        Field field;
+        while (tensor.next(field))
+        {
+            switch (field.number)
+            {
+            case 1: readVarints(field, initializer.dims); break; // dims
+            case 2: initializer.dataType = static_cast<int>(field.value); break;
+            case 4: // float_data, packed or not
+                if (field.wireType == FIXED32)
+                {
+                    float value;
+                    std::memcpy(&value, &field.value, sizeof(float));
+                    floatData.push_back(value);
+                }
+                else
+                {
+                    const size_t offset = floatData.size();
+                    floatData.resize(offset + (field.end - field.begin) / sizeof(float));
+                    std::memcpy(floatData.data() + offset, field.begin, (floatData.size() - offset) * sizeof(float));
+                }
+                break;
+            case 5: readVarints(field, int32Data); break; // int32_data, which is also used for int8
+            case 8: name.assign(field.begin, field.end); break;
+            case 9: // raw_data in little endian
+                rawBegin = field.begin;
+                rawEnd = field.end;
+                break;
+            default: break;
+            }
+        }
+
+        if (initializer.dataType == ONNXInitializer::FLOAT)
+        {
+            if (rawBegin)
+            {
+                initializer.data.resize((rawEnd - rawBegin) / sizeof(float));
+                std::memcpy(initializer.data.data(), rawBegin, initializer.data.size() * sizeof(float));
+            }
+            else { initializer.data = Eigen::Map<Eigen::ArrayXf>(floatData.data(), floatData.size()); }
+            return true;
+        }
+        if (initializer.dataType == ONNXInitializer::INT8)
+        {
+            if (rawBegin)
+            {
+                initializer.dataInt8.resize(rawEnd - rawBegin);
+                std::memcpy(initializer.dataInt8.data(), rawBegin, initializer.dataInt8.size());
+            }
+            else { initializer.dataInt8 = Eigen::Map<Eigen::Array<int32_t, Eigen::Dynamic, 1>>(int32Data.data(), int32Data.size()).cast<int8_t>(); }
+            return true;
+        }
+        return false;
+    }
+
+    // read repeated varint field that is packed or not
+    template <typename T>
+    static void readVarints(const Field &field, std::vector<T> &values)
+    {
+        if (field.wireType == VARINT)
+        {
+            values.push_back(static_cast<T>(field.value));
+            return;
+        }
+        Message packed{field.begin, field.end};
+        while (packed.position < packed.end)
+        {
+            values.push_back(static_cast<T>(packed.readVarint()));
+        }
+    }
+};
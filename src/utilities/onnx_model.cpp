@@ -0,0 +1,163 @@
+#include "utilities/onnx_model.h"
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+namespace
+{
+// ORTCHAR_T is defined in onnxruntime_c_api.h and is wchar_t on Windows, and char on Linux. Paths are ASCII, so the characters are converted one by one
+std::basic_string<ORTCHAR_T> toOrtPath(const std::string &path) { return std::basic_string<ORTCHAR_T>(path.begin(), path.end()); }
+
+// FNV-1a hash of the model, which is used in the name of the optimized graph so a changed model is not loaded from an old cached file
+uint64_t hashModel(const char *data, size_t size)
+{
+    uint64_t hash = 14695981039346656037ull;
+    for (size_t i = 0; i < size; i++)
+    {
+        hash ^= static_cast<uint8_t>(data[i]);
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+// file name of the model without directory and extension
+std::string getStem(const std::string &name)
+{
+    const size_t separator = name.find_last_of("/\\");
+    const size_t start = separator == std::string::npos ? 0 : separator + 1;
+    const size_t end = name.find_last_of('.');
+    return name.substr(start, (end == std::string::npos || end < start) ? std::string::npos : end - start);
+}
+
+// all settings and sessions are protected by the same mutex
+std::mutex modelMutex;
+std::map<std::string, std::pair<const char *, size_t>> registeredModels;
+std::string modelDirectory;
+std::string optimizedModelDirectory;
+
+// set modelData and modelSize to the registered buffer of the model, or read the model file into fileData. modelMutex must be locked
+void findModel(const std::string &name, std::vector<char> &fileData, const char *&modelData, size_t &modelSize)
+{
+    auto registered = registeredModels.find(name);
+    if (registered != registeredModels.end())
+    {
+        modelData = registered->second.first;
+        modelSize = registered->second.second;
+        return;
+    }
+    const std::string path = modelDirectory.empty() ? name : modelDirectory + "/" + name;
+    std::ifstream file(path, std::ios::binary);
+    if (!file) { throw std::runtime_error("Could not open ONNX file: " + path); }
+    fileData.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    modelData = fileData.data();
+    modelSize = fileData.size();
+}
+} // namespace
+
+Ort::Env &ONNXModel::getEnvironment()
+{
+    // static local variables are initialized once in a thread-safe way
+    static Ort::Env env = []() {
+        Ort::ThreadingOptions threadOptions;
+        threadOptions.SetGlobalInterOpNumThreads(2);
+        Ort::Env environment(threadOptions, ORT_LOGGING_LEVEL_WARNING, "global_environment");
+        environment.DisableTelemetryEvents();
+
+        // a single arena allocator is registered and used by all sessions (kOrtSessionOptionsConfigUseEnvAllocators). This can only be done once per process
+        size_t maxMemory = 0;           // 0 = default
+        int arenaExtendStrategy = -1;   // -1 = default
+        int initialChunkSizeBytes = -1; // -1 = default
+        int maxDeadBytesPerChunk = -1;  // -1 = default
+        Ort::ArenaCfg arenaCfg = Ort::ArenaCfg(maxMemory, arenaExtendStrategy, initialChunkSizeBytes, maxDeadBytesPerChunk);
+        Ort::MemoryInfo memInfo = Ort::MemoryInfo::CreateCpu(OrtAllocatorType::OrtArenaAllocator, OrtMemType::OrtMemTypeDefault);
+        environment.CreateAndRegisterAllocator(memInfo, arenaCfg);
+        return environment;
+    }();
+    return env;
+}
+
+void ONNXModel::registerModel(const std::string &name, const void *data, size_t size)
+{
+    std::lock_guard<std::mutex> lock(modelMutex);
+    registeredModels[name] = {static_cast<const char *>(data), size};
+}
+
+void ONNXModel::setModelDirectory(const std::string &directory)
+{
+    std::lock_guard<std::mutex> lock(modelMutex);
+    modelDirectory = directory;
+}
+
+void ONNXModel::setOptimizedModelDirectory(const std::string &directory)
+{
+    std::lock_guard<std::mutex> lock(modelMutex);
+    optimizedModelDirectory = directory;
+}
+
+std::vector<char> ONNXModel::readModel(const std::string &name)
+{
+    std::lock_guard<std::mutex> lock(modelMutex);
+    std::vector<char> fileData;
+    const char *modelData;
+    size_t modelSize;
+    findModel(name, fileData, modelData, modelSize);
+    if (fileData.empty()) { fileData.assign(modelData, modelData + modelSize); }
+    return fileData;
+}
+
+std::shared_ptr<Ort::Session> ONNXModel::getCachedSession(const std::string &name, GraphOptimizationLevel optimizationLevel)
+{
+    // sessions are stored as weak pointers, so they are released when no model uses them
+    static std::map<std::pair<std::string, int>, std::weak_ptr<Ort::Session>> sessions;
+
+    std::lock_guard<std::mutex> lock(modelMutex);
+    std::weak_ptr<Ort::Session> &sessionCached = sessions[{name, static_cast<int>(optimizationLevel)}];
+    std::shared_ptr<Ort::Session> session = sessionCached.lock();
+    if (!session)
+    {
+        // the model is read from the registered buffer or from the file, so it can be hashed before the session is created
+        std::vector<char> fileData;
+        const char *modelData;
+        size_t modelSize;
+        findModel(name, fileData, modelData, modelSize);
+
+        // memory pattern and CPU arena are enabled, since all shapes are fixed and the intermediate tensors can then be reused between runs
+        Ort::SessionOptions sessionOptions;
+        sessionOptions.SetGraphOptimizationLevel(optimizationLevel);
+        sessionOptions.DisablePerSessionThreads();
+        sessionOptions.DisableProfiling();
+        sessionOptions.AddConfigEntry(kOrtSessionOptionsConfigUseEnvAllocators, "1");
+
+        // inspired from: https://github.com/microsoft/onnxruntime/issues/11627
+        // runOption.AddConfigEntry(kOrtRunOptionsConfigEnableMemoryArenaShrinkage, "cpu:0;gpu:0");
+
+        if (!optimizedModelDirectory.empty())
+        {
+            char hash[17];
+            std::snprintf(hash, sizeof(hash), "%016llx", static_cast<unsigned long long>(hashModel(modelData, modelSize)));
+            const std::basic_string<ORTCHAR_T> optimizedPath =
+                toOrtPath(optimizedModelDirectory + "/" + getStem(name) + "_" + hash + "_" + std::to_string(static_cast<int>(optimizationLevel)) + ".ort");
+
+            // the cached graph is already optimized. If it can not be loaded (e.g. it is not written completely), it is made again from the model
+            if (std::ifstream(optimizedPath.c_str()).good())
+            {
+                try
+                {
+                    Ort::SessionOptions optimizedOptions = sessionOptions.Clone();
+                    optimizedOptions.SetGraphOptimizationLevel(GraphOptimizationLevel::ORT_DISABLE_ALL);
+                    session = std::make_shared<Ort::Session>(getEnvironment(), optimizedPath.c_str(), optimizedOptions);
+                }
+                catch (const Ort::Exception &) {}
+            }
+            if (!session) { sessionOptions.SetOptimizedModelFilePath(optimizedPath.c_str()); }
+        }
+        if (!session) { session = std::make_shared<Ort::Session>(getEnvironment(), modelData, modelSize, sessionOptions); }
+        sessionCached = session;
+    }
+    return session;
+}
@@ -0,0 +1,179 @@
+#pragma once
+#include "framework/framework.h"
+#include "onnxruntime_cxx_api.h"
+#include "onnxruntime_run_options_config_keys.h"
+#include "onnxruntime_session_options_config_keys.h"
+#include <memory>
+
+// ONNXModel use Row-major layout internally, so the input shape must be specified in such a way, i.e. a 2 x 4 x 64 tensor contains 2*4*64 = 512 elements where each 64 length
+// vector is placed contiguously in memory.
+//
+// ONNXModel only supports float data type as input/output.
+//
+// Inputs and outputs are bound to the callers buffers with setInput() and setOutput() before calling run(), so the model reads and writes them directly without
+// copies. Recurrent states that are outputs fed back as inputs in the next run are set with setState(). Each state has two buffers that are ping-ponged, so the
+// output of one run is the input of the next. Two IoBindings are prepared with all bindings, and run() alternates between them, so nothing is bound or allocated
+// while running.
+//
+// All models share a single ONNX Runtime environment with one inter-op thread pool and one arena allocator. Sessions are cached by model path and graph
+// optimization level, so models of the same file share the session and its weights, while each ONNXModel only holds its own bindings and states. A session is
+// released when the last model using it is destroyed.
+//
+// A model is found by its name: if a buffer is registered with that name by registerModel() (e.g. a model embedded in the binary), the session is created from
+// the buffer, and otherwise the name is a file path relative to the model directory (setModelDirectory(), default is the working directory). If a cache
+// directory is set by setOptimizedModelDirectory(), the optimized graph of a model is saved there in ORT format the first time its session is created, and
+// later sessions load the optimized graph instead of optimizing the model again. The cached file name contains a hash of the model, so a changed model gets
+// a new cached file. The optimized graph can depend on the CPU, so the cache directory should not be shared between machines.
+//
+// author: Kristian Timm Andersen
+class ONNXModel
+{
+  public:
+    ONNXModel(const std::string &mPath, const std::vector<std::string> &inNames, const std::vector<std::vector<int64_t>> &inShapes, const std::vector<std::string> &outNames,
+              const std::vector<std::vector<int64_t>> &outShapes, GraphOptimizationLevel optimizationLevel = GraphOptimizationLevel::ORT_ENABLE_ALL)
+        : modelName(mPath), inputNames(inNames), inputShapes(inShapes), outputNames(outNames), outputShapes(outShapes),
+          memInfo(Ort::MemoryInfo::CreateCpu(OrtAllocatorType::OrtArenaAllocator, OrtMemType::OrtMemTypeDefault)), session(getCachedSession(modelName, optimizationLevel))
+    {
+        ioBindings.emplace_back(*session.get());
+        ioBindings.emplace_back(*session.get());
+        stateIndex = 0;
+    }
+
+    ONNXModel(ONNXModel &&) = default;
+
+    // swap, so the resources of this are released by the destructor of other in the right order (bindings before session)
+    ONNXModel &operator=(ONNXModel &&other) noexcept
+    {
+        std::swap(modelName, other.modelName);
+        std::swap(inputNames, other.inputNames);
+        std::swap(inputShapes, other.inputShapes);
+        std::swap(outputNames, other.outputNames);
+        std::swap(outputShapes, other.outputShapes);
+        std::swap(memInfo, other.memInfo);
+        std::swap(session, other.session);
+        std::swap(runOption, other.runOption);
+        std::swap(stateData, other.stateData);
+        std::swap(tensors, other.tensors);
+        std::swap(ioBindings, other.ioBindings);
+        std::swap(stateIndex, other.stateIndex);
+        return *this;
+    }
+
+    // bind input i to data. data must have as many elements as the input shape, and it must stay valid (and not be resized) while the model is used
+    void setInput(int i, Eigen::Ref<Eigen::ArrayXXf> data)
+    {
+        assert((data.size() == getNElements(inputShapes[i])) && (data.outerStride() == data.rows()));
+        tensors.emplace_back(createTensor(data.data(), inputShapes[i]));
+        for (auto &ioBinding : ioBindings)
+        {
+            ioBinding.BindInput(inputNames[i].c_str(), tensors.back());
+        }
+    }
+
+    // bind output i to data. data must have as many elements as the output shape, and it must stay valid (and not be resized) while the model is used
+    void setOutput(int i, Eigen::Ref<Eigen::ArrayXXf> data)
+    {
+        assert((data.size() == getNElements(outputShapes[i])) && (data.outerStride() == data.rows()));
+        tensors.emplace_back(createTensor(data.data(), outputShapes[i]));
+        for (auto &ioBinding : ioBindings)
+        {
+            ioBinding.BindOutput(outputNames[i].c_str(), tensors.back());
+        }
+    }
+
+    // set output iOutput as a recurrent state that is fed back as input iInput in the next run. The state buffers are owned by the model and initialized to zero
+    void setState(int iInput, int iOutput)
+    {
+        const Eigen::Index nElements = getNElements(inputShapes[iInput]);
+        assert(nElements == getNElements(outputShapes[iOutput]));
+        stateData.emplace_back(Eigen::ArrayXf::Zero(nElements));
+        stateData.emplace_back(Eigen::ArrayXf::Zero(nElements));
+        tensors.emplace_back(createTensor(stateData[stateData.size() - 2].data(), inputShapes[iInput]));
+        tensors.emplace_back(createTensor(stateData.back().data(), inputShapes[iInput]));
+
+        // binding 0 reads the first buffer and writes the second, and binding 1 does the opposite
+        const size_t iTensor = tensors.size() - 2;
+        ioBindings[0].BindInput(inputNames[iInput].c_str(), tensors[iTensor]);
+        ioBindings[0].BindOutput(outputNames[iOutput].c_str(), tensors[iTensor + 1]);
+        ioBindings[1].BindInput(inputNames[iInput].c_str(), tensors[iTensor + 1]);
+        ioBindings[1].BindOutput(outputNames[iOutput].c_str(), tensors[iTensor]);
+    }
+
+    // run model on the bound buffers and swap the state buffers
+    void run()
+    {
+        session->Run(runOption, ioBindings[stateIndex]);
+        stateIndex = 1 - stateIndex;
+    }
+
+    // set recurrent states to zero
+    void resetStates()
+    {
+        for (auto &state : stateData)
+        {
+            state.setZero();
+        }
+        stateIndex = 0;
+    }
+
+    size_t getDynamicMemorySize() const
+    {
+        size_t size = 0;
+        for (const auto &state : stateData)
+        {
+            size += state.getDynamicMemorySize();
+        }
+        return size;
+    }
+
+    const Ort::Session *getSession() const { return session.get(); }
+
+    // environment shared by all models in the process. It is created on first use
+    static Ort::Env &getEnvironment();
+
+    // register a model buffer with a name, so models with that name are created from the buffer instead of a file. The buffer is not copied and must stay
+    // valid until the models are created
+    static void registerModel(const std::string &name, const void *data, size_t size);
+
+    // directory of model files that are not registered. Empty is the working directory
+    static void setModelDirectory(const std::string &directory);
+
+    // directory where optimized graphs are saved and loaded from. Empty disables the cache. The directory must exist
+    static void setOptimizedModelDirectory(const std::string &directory);
+
+    // return the model with this name, found in the same way as when a session is created. This is used to read the weights of models that are implemented
+    // natively. Throws std::runtime_error if the model is not registered and the file can not be read
+    static std::vector<char> readModel(const std::string &name);
+
+  private:
+    // return cached session for the model name and optimization level, or create it if it is not in use by any other model
+    static std::shared_ptr<Ort::Session> getCachedSession(const std::string &name, GraphOptimizationLevel optimizationLevel);
+
+    static Eigen::Index getNElements(const std::vector<int64_t> &shape)
+    {
+        Eigen::Index nElements = 1;
+        for (const auto &e : shape)
+        {
+            nElements *= static_cast<Eigen::Index>(e);
+        }
+        return nElements;
+    }
+
+    Ort::Value createTensor(float *data, const std::vector<int64_t> &shape) const
+    {
+        return Ort::Value::CreateTensor<float>(memInfo, data, static_cast<size_t>(getNElements(shape)), shape.data(), shape.size());
+    }
+
+    std::string modelName;
+    std::vector<std::string> inputNames;
+    std::vector<std::vector<int64_t>> inputShapes;
+    std::vector<std::string> outputNames;
+    std::vector<std::vector<int64_t>> outputShapes;
+    Ort::MemoryInfo memInfo;
+    std::shared_ptr<Ort::Session> session; // shared with other models of the same file
+    Ort::RunOptions runOption{nullptr};
+    std::vector<Eigen::ArrayXf> stateData;  // two buffers for each recurrent state
+    std::vector<Ort::Value> tensors;        // tensors pointing to the bound buffers
+    std::vector<Ort::IoBinding> ioBindings; // two bindings where the state buffers are swapped
+    int stateIndex;                         // index of the binding used in the next run
+};
@@ -0,0 +1,581 @@
+#pragma once
+#include "framework/framework.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <complex>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#if defined(__AVX512F__) || defined(__AVX2__) || defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <immintrin.h>
+#endif
+
+// Vectorized math functions on Eigen arrays of floats. The functions are calculated with SIMD vectors of the widest instruction set that the code is compiled
+// for (AVX-512, AVX2 with FMA or SSE2), and with a scalar version of the same approximation for the remaining elements and on other targets, so the result of
+// an element doesn't depend on its position. Inputs are arrays (or blocks of arrays) where each column is contiguous, and the output can be the same as the input.
+//
+// The approximations use range reduction and polynomials, and the maximum errors measured against double precision are:
+// - exp, exp2: relative error < 3e-7. The input is clipped to [-87, 88] for exp and [-126, 127] for exp2, so the output is never 0 or infinite
+// - dB2lin: relative error < 3e-7 + 1e-8 * |x|, where the second term is from rounding x * log2(10) / 20 to float
+// - log, log2, energy2dB: error < 3.5e-7 * max(1, |y|), where y is the output. The input must be a positive normal number
+// - pow: relative error < 2e-7 * (1 + |p * log2(x)|). The input must be a positive normal number
+// - sincos: absolute error < 1.2e-7 for |x| < 1000. The argument reduction loses accuracy for larger |x|
+// - atan2, arg: absolute error < 3.5e-7 radians. atan2(0, 0) is 0
+//
+// author: Kristian Timm Andersen
+namespace VectorMath
+{
+namespace Detail
+{
+
+// scalar version of the SIMD vectors, which is used for the remaining elements and when no instruction set is available
+struct VecScalar
+{
+    using Float = float;
+    using Int = int32_t;
+    using Mask = bool;
+    static constexpr int size = 1;
+
+    static Float load(const float *p) { return *p; }
+    static void store(float *p, Float x) { *p = x; }
+    static Float set(float x) { return x; }
+    static Float add(Float a, Float b) { return a + b; }
+    static Float sub(Float a, Float b) { return a - b; }
+    static Float mul(Float a, Float b) { return a * b; }
+    static Float div(Float a, Float b) { return a / b; }
+    static Float mulAdd(Float a, Float b, Float c) { return a * b + c; }
+    static Float min(Float a, Float b) { return a < b ? a : b; }
+    static Float max(Float a, Float b) { return a > b ? a : b; }
+    static Float abs(Float a) { return std::fabs(a); }
+    static Mask less(Float a, Float b) { return a < b; }
+    static Mask greater(Float a, Float b) { return a > b; }
+    static Float select(Mask m, Float a, Float b) { return m ? a : b; }
+    static Int round(Float x) { return static_cast<Int>(std::lrint(x)); }
+    static Float toFloat(Int i) { return static_cast<Float>(i); }
+    static Int addInt(Int a, int b) { return a + b; }
+    static Mask bitIsSet(Int a, int bit) { return (a & bit) != 0; }
+
+    // 2^n for n in [-126, 127]
+    static Float pow2(Int n)
+    {
+        const int32_t bits = (n + 127) << 23;
+        float y;
+        std::memcpy(&y, &bits, sizeof(y));
+        return y;
+    }
+
+    // split positive normal number into exponent and mantissa in [1, 2)
+    static Int exponent(Float x)
+    {
+        int32_t bits;
+        std::memcpy(&bits, &x, sizeof(bits));
+        return (bits >> 23) - 127;
+    }
+
+    static Float mantissa(Float x)
+    {
+        int32_t bits;
+        std::memcpy(&bits, &x, sizeof(bits));
+        bits = (bits & 0x007FFFFF) | 0x3F800000;
+        float y;
+        std::memcpy(&y, &bits, sizeof(y));
+        return y;
+    }
+};
+
+#if defined(__AVX512F__)
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized" // false positive from _mm512_undefined_ps() inside the GCC intrinsics
+#endif
+struct VecAVX512
+{
+    using Float = __m512;
+    using Int = __m512i;
+    using Mask = __mmask16;
+    static constexpr int size = 16;
+
+    static Float load(const float *p) { return _mm512_loadu_ps(p); }
+    static void store(float *p, Float x) { _mm512_storeu_ps(p, x); }
+    static Float set(float x) { return _mm512_set1_ps(x); }
+    static Float add(Float a, Float b) { return _mm512_add_ps(a, b); }
+    static Float sub(Float a, Float b) { return _mm512_sub_ps(a, b); }
+    static Float mul(Float a, Float b) { return _mm512_mul_ps(a, b); }
+    static Float div(Float a, Float b) { return _mm512_div_ps(a, b); }
+    static Float mulAdd(Float a, Float b, Float c) { return _mm512_fmadd_ps(a, b, c); }
+    static Float min(Float a, Float b) { return _mm512_min_ps(a, b); }
+    static Float max(Float a, Float b) { return _mm512_max_ps(a, b); }
+    static Float abs(Float a) { return _mm512_abs_ps(a); }
+    static Mask less(Float a, Float b) { return _mm512_cmp_ps_mask(a, b, _CMP_LT_OQ); }
+    static Mask greater(Float a, Float b) { return _mm512_cmp_ps_mask(a, b, _CMP_GT_OQ); }
+    static Float select(Mask m, Float a, Float b) { return _mm512_mask_blend_ps(m, b, a); }
+    static Int round(Float x) { return _mm512_cvtps_epi32(x); }
+    static Float toFloat(Int i) { return _mm512_cvtepi32_ps(i); }
+    static Int addInt(Int a, int b) { return _mm512_add_epi32(a, _mm512_set1_epi32(b)); }
+    static Mask bitIsSet(Int a, int bit) { return _mm512_test_epi32_mask(a, _mm512_set1_epi32(bit)); }
+    static Float pow2(Int n) { return _mm512_castsi512_ps(_mm512_slli_epi32(_mm512_add_epi32(n, _mm512_set1_epi32(127)), 23)); }
+    static Int exponent(Float x) { return _mm512_sub_epi32(_mm512_srli_epi32(_mm512_castps_si512(x), 23), _mm512_set1_epi32(127)); }
+    static Float mantissa(Float x)
+    {
+        const Int bits = _mm512_and_si512(_mm512_castps_si512(x), _mm512_set1_epi32(0x007FFFFF));
+        return _mm512_castsi512_ps(_mm512_or_si512(bits, _mm512_set1_epi32(0x3F800000)));
+    }
+};
+using VecNative = VecAVX512;
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
+#elif defined(__AVX2__) && defined(__FMA__)
+struct VecAVX2
+{
+    using Float = __m256;
+    using Int = __m256i;
+    using Mask = __m256;
+    static constexpr int size = 8;
+
+    static Float load(const float *p) { return _mm256_loadu_ps(p); }
+    static void store(float *p, Float x) { _mm256_storeu_ps(p, x); }
+    static Float set(float x) { return _mm256_set1_ps(x); }
+    static Float add(Float a, Float b) { return _mm256_add_ps(a, b); }
+    static Float sub(Float a, Float b) { return _mm256_sub_ps(a, b); }
+    static Float mul(Float a, Float b) { return _mm256_mul_ps(a, b); }
+    static Float div(Float a, Float b) { return _mm256_div_ps(a, b); }
+    static Float mulAdd(Float a, Float b, Float c) { return _mm256_fmadd_ps(a, b, c); }
+    static Float min(Float a, Float b) { return _mm256_min_ps(a, b); }
+    static Float max(Float a, Float b) { return _mm256_max_ps(a, b); }
+    static Float abs(Float a) { return _mm256_andnot_ps(_mm256_set1_ps(-0.f), a); }
+    static Mask less(Float a, Float b) { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+    static Mask greater(Float a, Float b) { return _mm256_cmp_ps(a, b, _CMP_GT_OQ); }
+    static Float select(Mask m, Float a, Float b) { return _mm256_blendv_ps(b, a, m); }
+    static Int round(Float x) { return _mm256_cvtps_epi32(x); }
+    static Float toFloat(Int i) { return _mm256_cvtepi32_ps(i); }
+    static Int addInt(Int a, int b) { return _mm256_add_epi32(a, _mm256_set1_epi32(b)); }
+    static Mask bitIsSet(Int a, int bit)
+    {
+        const Int bitVector = _mm256_set1_epi32(bit);
+        return _mm256_castsi256_ps(_mm256_cmpeq_epi32(_mm256_and_si256(a, bitVector), bitVector));
+    }
+    static Float pow2(Int n) { return _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_add_epi32(n, _mm256_set1_epi32(127)), 23)); }
+    static Int exponent(Float x) { return _mm256_sub_epi32(_mm256_srli_epi32(_mm256_castps_si256(x), 23), _mm256_set1_epi32(127)); }
+    static Float mantissa(Float x)
+    {
+        const Int bits = _mm256_and_si256(_mm256_castps_si256(x), _mm256_set1_epi32(0x007FFFFF));
+        return _mm256_castsi256_ps(_mm256_or_si256(bits, _mm256_set1_epi32(0x3F800000)));
+    }
+};
+using VecNative = VecAVX2;
+
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+struct VecSSE2
+{
+    using Float = __m128;
+    using Int = __m128i;
+    using Mask = __m128;
+    static constexpr int size = 4;
+
+    static Float load(const float *p) { return _mm_loadu_ps(p); }
+    static void store(float *p, Float x) { _mm_storeu_ps(p, x); }
+    static Float set(float x) { return _mm_set1_ps(x); }
+    static Float add(Float a, Float b) { return _mm_add_ps(a, b); }
+    static Float sub(Float a, Float b) { return _mm_sub_ps(a, b); }
+    static Float mul(Float a, Float b) { return _mm_mul_ps(a, b); }
+    static Float div(Float a, Float b) { return _mm_div_ps(a, b); }
+    static Float mulAdd(Float a, Float b, Float c) { return _mm_add_ps(_mm_mul_ps(a, b), c); }
+    static Float min(Float a, Float b) { return _mm_min_ps(a, b); }
+    static Float max(Float a, Float b) { return _mm_max_ps(a, b); }
+    static Float abs(Float a) { return _mm_andnot_ps(_mm_set1_ps(-0.f), a); }
+    static Mask less(Float a, Float b) { return _mm_cmplt_ps(a, b); }
+    static Mask greater(Float a, Float b) { return _mm_cmpgt_ps(a, b); }
+    static Float select(Mask m, Float a, Float b) { return _mm_or_ps(_mm_and_ps(m, a), _mm_andnot_ps(m, b)); }
+    static Int round(Float x) { return _mm_cvtps_epi32(x); }
+    static Float toFloat(Int i) { return _mm_cvtepi32_ps(i); }
+    static Int addInt(Int a, int b) { return _mm_add_epi32(a, _mm_set1_epi32(b)); }
+    static Mask bitIsSet(Int a, int bit)
+    {
+        const Int bitVector = _mm_set1_epi32(bit);
+        return _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(a, bitVector), bitVector));
+    }
+    static Float pow2(Int n) { return _mm_castsi128_ps(_mm_slli_epi32(_mm_add_epi32(n, _mm_set1_epi32(127)), 23)); }
+    static Int exponent(Float x) { return _mm_sub_epi32(_mm_srli_epi32(_mm_castps_si128(x), 23), _mm_set1_epi32(127)); }
+    static Float mantissa(Float x)
+    {
+        const Int bits = _mm_and_si128(_mm_castps_si128(x), _mm_set1_epi32(0x007FFFFF));
+        return _mm_castsi128_ps(_mm_or_si128(bits, _mm_set1_epi32(0x3F800000)));
+    }
+};
+using VecNative = VecSSE2;
+
+#else
+using VecNative = VecScalar;
+#endif
+
+// return x unchanged, but stop the compiler from reassociating the operations before and after with -ffast-math. Otherwise x - n * c1 - n * c2 is simplified
+// to x - n * (c1 + c2), which removes the extra precision of the argument reductions in exp and sincos
+template <typename T>
+inline T keep(T x)
+{
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__SSE2__))
+    __asm__("" : "+v"(x));
+    return x;
+#else
+    volatile T y = x;
+    return y;
+#endif
+}
+
+// e^r for |r| <= ln(2)/2 with a Taylor polynomial of order 6
+template <typename V>
+inline typename V::Float expReduced(typename V::Float r)
+{
+    typename V::Float p = V::mulAdd(V::set(1.f / 720.f), r, V::set(1.f / 120.f));
+    p = V::mulAdd(p, r, V::set(1.f / 24.f));
+    p = V::mulAdd(p, r, V::set(1.f / 6.f));
+    p = V::mulAdd(p, r, V::set(0.5f));
+    p = V::mulAdd(p, r, V::set(1.f));
+    return V::mulAdd(p, r, V::set(1.f));
+}
+
+// 2^x = 2^n * e^((x - n) * ln(2)) where n is x rounded to nearest integer
+template <typename V>
+inline typename V::Float exp2(typename V::Float x)
+{
+    x = V::min(V::max(x, V::set(-126.f)), V::set(127.f));
+    const typename V::Int n = V::round(x);
+    const typename V::Float r = V::mul(V::sub(x, V::toFloat(n)), V::set(0.693147180559945f));
+    return V::mul(expReduced<V>(r), V::pow2(n));
+}
+
+// e^x = 2^n * e^(x - n * ln(2)) where n is x / ln(2) rounded to nearest integer. ln(2) is split in two parts, so x - n * ln(2) is calculated accurately
+template <typename V>
+inline typename V::Float exp(typename V::Float x)
+{
+    x = V::min(V::max(x, V::set(-87.f)), V::set(88.f));
+    const typename V::Int n = V::round(V::mul(x, V::set(1.442695040888963f)));
+    const typename V::Float nFloat = V::toFloat(n);
+    typename V::Float r = keep(V::mulAdd(nFloat, V::set(-0.693359375f), x));
+    r = V::mulAdd(nFloat, V::set(2.12194440e-4f), r);
+    return V::mul(expReduced<V>(r), V::pow2(n));
+}
+
+// ln(x) = e * ln(2) + ln(m) where x = 2^e * m and m is in [sqrt(0.5), sqrt(2)). ln(m) = 2 * atanh(t) with t = (m - 1) / (m + 1), which is calculated with the
+// Taylor series of atanh to order 9. The exponent e is returned in exponentFloat
+template <typename V>
+inline typename V::Float logMantissa(typename V::Float x, typename V::Float &exponentFloat)
+{
+    typename V::Float m = V::mantissa(x);
+    exponentFloat = V::toFloat(V::exponent(x));
+    const typename V::Mask isLarge = V::greater(m, V::set(1.414213562373095f));
+    m = V::select(isLarge, V::mul(m, V::set(0.5f)), m);
+    exponentFloat = V::add(exponentFloat, V::select(isLarge, V::set(1.f), V::set(0.f)));
+    const typename V::Float t = V::div(V::sub(m, V::set(1.f)), V::add(m, V::set(1.f)));
+    const typename V::Float t2 = V::mul(t, t);
+    typename V::Float p = V::mulAdd(V::set(2.f / 9.f), t2, V::set(2.f / 7.f));
+    p = V::mulAdd(p, t2, V::set(2.f / 5.f));
+    p = V::mulAdd(p, t2, V::set(2.f / 3.f));
+    p = V::mulAdd(p, t2, V::set(2.f));
+    return V::mul(p, t);
+}
+
+template <typename V>
+inline typename V::Float log(typename V::Float x)
+{
+    typename V::Float exponentFloat;
+    const typename V::Float logM = logMantissa<V>(x, exponentFloat);
+    return V::mulAdd(exponentFloat, V::set(0.693147180559945f), logM);
+}
+
+template <typename V>
+inline typename V::Float log2(typename V::Float x)
+{
+    typename V::Float exponentFloat;
+    const typename V::Float logM = logMantissa<V>(x, exponentFloat);
+    return V::mulAdd(logM, V::set(1.442695040888963f), exponentFloat);
+}
+
+// sin(x) and cos(x) from r = x - n * pi/2, where n is x / (pi/2) rounded to nearest integer and |r| <= pi/4. pi/2 is split in three parts, so r is calculated
+// accurately. sin(r) and cos(r) are Taylor polynomials of order 9 and 8, and the quadrant n swaps and negates them
+template <typename V>
+inline void sincos(typename V::Float x, typename V::Float &s, typename V::Float &c)
+{
+    const typename V::Int n = V::round(V::mul(x, V::set(0.636619772367581f)));
+    const typename V::Float nFloat = V::toFloat(n);
+    typename V::Float r = keep(V::mulAdd(nFloat, V::set(-1.5703125f), x));
+    r = keep(V::mulAdd(nFloat, V::set(-4.837512969970703125e-4f), r));
+    r = V::mulAdd(nFloat, V::set(-7.54978995489188216e-8f), r);
+    const typename V::Float r2 = V::mul(r, r);
+
+    typename V::Float sinR = V::mulAdd(V::set(1.f / 362880.f), r2, V::set(-1.f / 5040.f));
+    sinR = V::mulAdd(sinR, r2, V::set(1.f / 120.f));
+    sinR = V::mulAdd(sinR, r2, V::set(-1.f / 6.f));
+    sinR = V::mulAdd(V::mul(sinR, r2), r, r);
+
+    typename V::Float cosR = V::mulAdd(V::set(1.f / 40320.f), r2, V::set(-1.f / 720.f));
+    cosR = V::mulAdd(cosR, r2, V::set(1.f / 24.f));
+    cosR = V::mulAdd(cosR, r2, V::set(-0.5f));
+    cosR = V::mulAdd(cosR, r2, V::set(1.f));
+
+    const typename V::Mask swap = V::bitIsSet(n, 1);
+    s = V::select(swap, cosR, sinR);
+    c = V::select(swap, sinR, cosR);
+    s = V::select(V::bitIsSet(n, 2), V::sub(V::set(0.f), s), s);
+    c = V::select(V::bitIsSet(V::addInt(n, 1), 2), V::sub(V::set(0.f), c), c);
+}
+
+// atan2(y, x) from atan(z) with z = min(|x|, |y|) / max(|x|, |y|) in [0, 1]. If z > tan(pi/8), atan(z) = pi/4 + atan((z - 1) / (z + 1)), so the argument of
+// the polynomial is in [-tan(pi/8), tan(pi/8)]. The polynomial is from the Cephes library (atanf.c)
+template <typename V>
+inline typename V::Float atan2(typename V::Float y, typename V::Float x)
+{
+    const typename V::Float xAbs = V::abs(x);
+    const typename V::Float yAbs = V::abs(y);
+    const typename V::Float z = V::div(V::min(xAbs, yAbs), V::max(V::max(xAbs, yAbs), V::set(1.17549435e-38f))); // atan2(0, 0) = 0
+    const typename V::Mask isLarge = V::greater(z, V::set(0.414213562373095f));
+    const typename V::Float w = V::select(isLarge, V::div(V::sub(z, V::set(1.f)), V::add(z, V::set(1.f))), z);
+    const typename V::Float w2 = V::mul(w, w);
+    typename V::Float p = V::mulAdd(V::set(8.05374449538e-2f), w2, V::set(-1.38776856032e-1f));
+    p = V::mulAdd(p, w2, V::set(1.99777106478e-1f));
+    p = V::mulAdd(p, w2, V::set(-3.33329491539e-1f));
+    typename V::Float angle = V::mulAdd(V::mul(p, w2), w, w);
+    angle = V::add(angle, V::select(isLarge, V::set(0.785398163397448f), V::set(0.f)));
+
+    angle = V::select(V::greater(yAbs, xAbs), V::sub(V::set(1.570796326794897f), angle), angle);
+    angle = V::select(V::less(x, V::set(0.f)), V::sub(V::set(3.141592653589793f), angle), angle);
+    return V::select(V::less(y, V::set(0.f)), V::sub(V::set(0.f), angle), angle);
+}
+
+// functions of one input and one output, that are applied with SIMD vectors and then scalar on the remaining elements
+struct Exp
+{
+    template <typename V>
+    typename V::Float apply(typename V::Float x) const
+    {
+        return exp<V>(x);
+    }
+};
+
+struct Exp2
+{
+    float scale; // 2^(scale * x)
+    template <typename V>
+    typename V::Float apply(typename V::Float x) const
+    {
+        return exp2<V>(V::mul(x, V::set(scale)));
+    }
+};
+
+struct Log
+{
+    template <typename V>
+    typename V::Float apply(typename V::Float x) const
+    {
+        return log<V>(x);
+    }
+};
+
+struct Log2
+{
+    float scale; // scale * log2(x)
+    template <typename V>
+    typename V::Float apply(typename V::Float x) const
+    {
+        return V::mul(log2<V>(x), V::set(scale));
+    }
+};
+
+struct Pow
+{
+    float p;
+    template <typename V>
+    typename V::Float apply(typename V::Float x) const
+    {
+        return exp2<V>(V::mul(log2<V>(x), V::set(p)));
+    }
+};
+
+template <typename Function>
+inline void applyUnary(const float *x, float *y, int n, const Function &f)
+{
+    int i = 0;
+    for (; i <= n - VecNative::size; i += VecNative::size)
+    {
+        VecNative::store(y + i, f.template apply<VecNative>(VecNative::load(x + i)));
+    }
+    for (; i < n; i++)
+    {
+        y[i] = f.template apply<VecScalar>(x[i]);
+    }
+}
+
+template <typename Function>
+inline void applyUnary(I::Real2D x, O::Real2D y, const Function &f)
+{
+    assert((x.rows() == y.rows()) && (x.cols() == y.cols()));
+    for (auto channel = 0; channel < x.cols(); channel++)
+    {
+        applyUnary(x.col(channel).data(), y.col(channel).data(), static_cast<int>(x.rows()), f);
+    }
+}
+
+inline void sincos(const float *x, float *s, float *c, int n)
+{
+    int i = 0;
+    for (; i <= n - VecNative::size; i += VecNative::size)
+    {
+        VecNative::Float sVector, cVector;
+        Detail::sincos<VecNative>(VecNative::load(x + i), sVector, cVector);
+        VecNative::store(s + i, sVector);
+        VecNative::store(c + i, cVector);
+    }
+    for (; i < n; i++)
+    {
+        Detail::sincos<VecScalar>(x[i], s[i], c[i]);
+    }
+}
+
+inline void atan2(const float *y, const float *x, float *angle, int n)
+{
+    int i = 0;
+    for (; i <= n - VecNative::size; i += VecNative::size)
+    {
+        VecNative::store(angle + i, Detail::atan2<VecNative>(VecNative::load(y + i), VecNative::load(x + i)));
+    }
+    for (; i < n; i++)
+    {
+        angle[i] = Detail::atan2<VecScalar>(y[i], x[i]);
+    }
+}
+
+// complex arrays are split into real and imaginary parts in blocks of this size on the stack, so no memory is allocated
+constexpr int nBlock = 64;
+
+// false if x is an expression that is evaluated into a temporary array on the heap when it is passed as I::Real2D or I::Complex2D
+template <typename Derived>
+struct IsDirectAccess
+{
+    static constexpr bool value = (Derived::Flags & Eigen::DirectAccessBit) && (Derived::InnerStrideAtCompileTime == 1);
+};
+
+template <typename Derived>
+using EnableIfExpression = typename std::enable_if<!IsDirectAccess<Derived>::value>::type;
+
+} // namespace Detail
+
+// Passing an expression such as x.max(minValue) would silently allocate a temporary array in every call, so these overloads make it a compile error. Write the
+// expression to a preallocated buffer first and pass the buffer.
+template <typename Derived, typename = Detail::EnableIfExpression<Derived>>
+void exp(const Eigen::ArrayBase<Derived> &x, O::Real2D y) = delete;
+template <typename Derived, typename = Detail::EnableIfExpression<Derived>>
+void exp2(const Eigen::ArrayBase<Derived> &x, O::Real2D y) = delete;
+template <typename Derived, typename = Detail::EnableIfExpression<Derived>>
+void log(const Eigen::ArrayBase<Derived> &x, O::Real2D y) = delete;
+template <typename Derived, typename = Detail::EnableIfExpression<Derived>>
+void log2(const Eigen::ArrayBase<Derived> &x, O::Real2D y) = delete;
+template <typename Derived, typename = Detail::EnableIfExpression<Derived>>
+void pow(const Eigen::ArrayBase<Derived> &x, float p, O::Real2D y) = delete;
+template <typename Derived, typename = Detail::EnableIfExpression<Derived>>
+void energy2dB(const Eigen::ArrayBase<Derived> &x, O::Real2D y) = delete;
+template <typename Derived, typename = Detail::EnableIfExpression<Derived>>
+void dB2lin(const Eigen::ArrayBase<Derived> &x, O::Real2D y) = delete;
+template <typename Derived, typename = Detail::EnableIfExpression<Derived>>
+void sincos(const Eigen::ArrayBase<Derived> &x, O::Real2D s, O::Real2D c) = delete;
+template <typename Derived, typename = Detail::EnableIfExpression<Derived>>
+void atan2(const Eigen::ArrayBase<Derived> &y, I::Real2D x, O::Real2D angle) = delete;
+template <typename Derived, typename = Detail::EnableIfExpression<Derived>>
+void atan2(I::Real2D y, const Eigen::ArrayBase<Derived> &x, O::Real2D angle) = delete;
+template <typename Derived, typename = Detail::EnableIfExpression<Derived>>
+void arg(const Eigen::ArrayBase<Derived> &x, O::Real2D angle) = delete;
+template <typename Derived, typename = Detail::EnableIfExpression<Derived>>
+void expComplex(const Eigen::ArrayBase<Derived> &x, O::Complex2D y) = delete;
+
+// e^x
+inline void exp(I::Real2D x, O::Real2D y) { Detail::applyUnary(x, y, Detail::Exp{}); }
+
+// 2^x
+inline void exp2(I::Real2D x, O::Real2D y) { Detail::applyUnary(x, y, Detail::Exp2{1.f}); }
+
+// natural logarithm
+inline void log(I::Real2D x, O::Real2D y) { Detail::applyUnary(x, y, Detail::Log{}); }
+
+inline void log2(I::Real2D x, O::Real2D y) { Detail::applyUnary(x, y, Detail::Log2{1.f}); }
+
+// x^p = 2^(p * log2(x))
+inline void pow(I::Real2D x, float p, O::Real2D y) { Detail::applyUnary(x, y, Detail::Pow{p}); }
+
+// 10*log10(x) = 10/log2(10)*log2(x) = 3.010299956639812*log2(x)
+inline void energy2dB(I::Real2D x, O::Real2D y) { Detail::applyUnary(x, y, Detail::Log2{3.010299956639812f}); }
+
+// 10^(x/20) = 2^(log2(10)*x/20) = 2^(0.166096404744368*x)
+inline void dB2lin(I::Real2D x, O::Real2D y) { Detail::applyUnary(x, y, Detail::Exp2{0.166096404744368f}); }
+
+// sin(x) and cos(x)
+inline void sincos(I::Real2D x, O::Real2D s, O::Real2D c)
+{
+    assert((x.rows() == s.rows()) && (x.cols() == s.cols()) && (x.rows() == c.rows()) && (x.cols() == c.cols()));
+    for (auto channel = 0; channel < x.cols(); channel++)
+    {
+        Detail::sincos(x.col(channel).data(), s.col(channel).data(), c.col(channel).data(), static_cast<int>(x.rows()));
+    }
+}
+
+// angle of (x, y) in [-pi, pi]
+inline void atan2(I::Real2D y, I::Real2D x, O::Real2D angle)
+{
+    assert((x.rows() == y.rows()) && (x.cols() == y.cols()) && (x.rows() == angle.rows()) && (x.cols() == angle.cols()));
+    for (auto channel = 0; channel < x.cols(); channel++)
+    {
+        Detail::atan2(y.col(channel).data(), x.col(channel).data(), angle.col(channel).data(), static_cast<int>(x.rows()));
+    }
+}
+
+// angle of complex numbers in [-pi, pi]. Same as x.arg() in Eigen
+inline void arg(I::Complex2D x, O::Real2D angle)
+{
+    assert((x.rows() == angle.rows()) && (x.cols() == angle.cols()));
+    float real[Detail::nBlock], imag[Detail::nBlock];
+    for (auto channel = 0; channel < x.cols(); channel++)
+    {
+        for (auto start = 0; start < x.rows(); start += Detail::nBlock)
+        {
+            const int n = std::min(Detail::nBlock, static_cast<int>(x.rows()) - start);
+            const std::complex<float> *xPtr = x.col(channel).data() + start;
+            for (auto i = 0; i < n; i++)
+            {
+                real[i] = xPtr[i].real();
+                imag[i] = xPtr[i].imag();
+            }
+            Detail::atan2(imag, real, angle.col(channel).data() + start, n);
+        }
+    }
+}
+
+// complex exponential exp(x + iy) = exp(x) * (cos(y) + i * sin(y))
+inline void expComplex(I::Complex2D x, O::Complex2D y)
+{
+    assert((x.rows() == y.rows()) && (x.cols() == y.cols()));
+    float magnitude[Detail::nBlock], s[Detail::nBlock], c[Detail::nBlock];
+    for (auto channel = 0; channel < x.cols(); channel++)
+    {
+        for (auto start = 0; start < x.rows(); start += Detail::nBlock)
+        {
+            const int n = std::min(Detail::nBlock, static_cast<int>(x.rows()) - start);
+            const std::complex<float> *xPtr = x.col(channel).data() + start;
+            for (auto i = 0; i < n; i++)
+            {
+                magnitude[i] = xPtr[i].real();
+                s[i] = xPtr[i].imag();
+            }
+            Detail::applyUnary(magnitude, magnitude, n, Detail::Exp{});
+            Detail::sincos(s, s, c, n);
+            std::complex<float> *yPtr = y.col(channel).data() + start;
+            for (auto i = 0; i < n; i++)
+            {
+                yPtr[i] = std::complex<float>(magnitude[i] * c[i], magnitude[i] * s[i]);
+            }
+        }
+    }
+}
+
+} // namespace VectorMath